@@ -32,14 +32,14 @@ public:
 	FORCE_INLINE void	Add ( int iBlock ) { m_dBlocks.push_back(iBlock); }
 	FORCE_INLINE int	GetBlock ( int iBlock ) const { return m_dBlocks[iBlock]; }
 	FORCE_INLINE int	GetNumBlocks() const { return (int)m_dBlocks.size(); }
-	FORCE_INLINE int	Find ( int iStartBlock, int iValue );
+	FORCE_INLINE int	Find ( int iStartBlock, int iValue ) const;
 
 private:
 	std::vector<int>	m_dBlocks;
 };
 
 
-int MatchingBlocks_c::Find ( int iStartBlock, int iValue )
+int MatchingBlocks_c::Find ( int iStartBlock, int iValue ) const
 {
 	auto tFound = std::lower_bound ( m_dBlocks.begin()+iStartBlock, m_dBlocks.end(), iValue );
 	if ( tFound==m_dBlocks.end() )
@@ -100,13 +100,48 @@ int64_t StoredBlock_Bool_Bitmap_c::GetValue ( int iIdInSubblock )
 
 //////////////////////////////////////////////////////////////////////////
 
+class StoredBlock_Bool_RLE_c
+{
+public:
+							StoredBlock_Bool_RLE_c ( const std::string & sCodec32, const std::string & sCodec64 );
+
+	template <typename RD> FORCE_INLINE void ReadHeader ( RD & tReader );
+	FORCE_INLINE int64_t	GetValue ( uint32_t uIdInBlock )	{ return GetRunValue ( m_tRuns.FindRun(uIdInBlock) ); }
+	FORCE_INLINE int64_t	GetRunValue ( int iRun ) const		{ return ( m_bFirstValue ? 1 : 0 ) ^ ( iRun & 1 ); }	// runs alternate
+	FORCE_INLINE BlockRuns_c & GetRuns()						{ return m_tRuns; }
+
+private:
+	IntCodecPooledPtr_t		m_pCodec;
+	bool					m_bFirstValue = false;
+	BlockRuns_c				m_tRuns;
+};
+
+
+StoredBlock_Bool_RLE_c::StoredBlock_Bool_RLE_c ( const std::string & sCodec32, const std::string & sCodec64 )
+	: m_pCodec ( CreateIntCodec ( sCodec32, sCodec64 ) )
+{}
+
+
+template <typename RD>
+void StoredBlock_Bool_RLE_c::ReadHeader ( RD & tReader )
+{
+	m_bFirstValue = !!tReader.Read_uint8();
+	int iNumRuns = (int)tReader.Unpack_uint32();
+	m_tRuns.Read ( tReader, iNumRuns, *m_pCodec );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 template <typename RD=util::FileReader_c>
 class Accessor_Bool_T : public StoredBlockTraits_t
 {
 public:
 						Accessor_Bool_T ( const AttributeHeader_i & tHeader, RD * pReader );
+						~Accessor_Bool_T() { UpdateCounters ( *m_pReader, m_tHeader, 0 ); }
 
 	FORCE_INLINE void	SetCurBlock ( uint32_t uBlockId );
+	FORCE_INLINE void	PrefetchBlock ( int iBlock ) const	{ PrefetchBlockData ( *m_pReader, m_tHeader, iBlock ); }
+	FORCE_INLINE int	GetNumBlocks() const				{ return m_tHeader.GetNumBlocks(); }
 
 protected:
 	const AttributeHeader_i &		m_tHeader;
@@ -114,6 +149,7 @@ protected:
 
 	StoredBlock_Bool_Const_c		m_tBlockConst;
 	StoredBlock_Bool_Bitmap_c		m_tBlockBitmap;
+	StoredBlock_Bool_RLE_c			m_tBlockRLE;
 
 	int64_t (Accessor_Bool_T<RD>::*m_fnReadValue)() = nullptr;
 
@@ -121,6 +157,7 @@ protected:
 
 	int64_t			ReadValue_Const();
 	int64_t			ReadValue_Bitmap();
+	int64_t			ReadValue_RLE();
 };
 
 
@@ -130,6 +167,7 @@ Accessor_Bool_T<RD>::Accessor_Bool_T ( const AttributeHeader_i & tHeader, RD * p
 	, m_tHeader ( tHeader )
 	, m_pReader ( pReader )
 	, m_tBlockBitmap ( tHeader.GetSettings().m_iSubblockSize )
+	, m_tBlockRLE ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64 )
 {
 	assert(pReader);
 }
@@ -138,6 +176,7 @@ Accessor_Bool_T<RD>::Accessor_Bool_T ( const AttributeHeader_i & tHeader, RD * p
 template <typename RD>
 void Accessor_Bool_T<RD>::SetCurBlock ( uint32_t uBlockId )
 {
+	UpdateCounters ( *m_pReader, m_tHeader, 1 );
 	m_pReader->Seek ( m_tHeader.GetBlockOffset(uBlockId) );
 	m_ePacking = (BoolPacking_e)m_pReader->Unpack_uint32();
 
@@ -157,6 +196,11 @@ void Accessor_Bool_T<RD>::SetCurBlock ( uint32_t uBlockId )
 		m_tBlockBitmap.ReadHeader ( *m_pReader, uDocsInBlock );
 		break;
 
+	case BoolPacking_e::RLE:
+		m_fnReadValue = &Accessor_Bool_T<RD>::ReadValue_RLE;
+		m_tBlockRLE.ReadHeader ( *m_pReader );
+		break;
+
 	default:
 		assert ( 0 && "Packing not implemented yet" );
 	}
@@ -181,6 +225,13 @@ int64_t Accessor_Bool_T<RD>::ReadValue_Bitmap()
 	return m_tBlockBitmap.GetValue ( GetValueIdInSubblock(uIdInBlock) );
 }
 
+
+template <typename RD>
+int64_t Accessor_Bool_T<RD>::ReadValue_RLE()
+{
+	return m_tBlockRLE.GetValue ( m_tRequestedRowID - m_tStartBlockRowId );
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 template <typename RD=util::FileReader_c>
@@ -191,27 +242,67 @@ class Iterator_Bool_T : public Iterator_i, public Accessor_Bool_T<RD>
 
 public:
 	int64_t		Get ( uint32_t tRowID ) final			{ return DoGet(tRowID); }
-	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final;
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final	{ DoFetch ( dRowIDs, dValues.data() ); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<uint32_t> & dValues ) final	{ DoFetch ( dRowIDs, dValues.data() ); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<uint8_t> & dValues ) final	{ DoFetch ( dRowIDs, dValues.data() ); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<float> & dValues ) final		{ DoFetch ( dRowIDs, dValues.data() ); }
 
 	int			Get ( uint32_t tRowID, const uint8_t * & pData ) final	{ assert ( 0 && "INTERNAL ERROR: requesting blob from bool iterator" ); return 0; }
 	uint8_t *	GetPacked ( uint32_t tRowID ) final						{ assert ( 0 && "INTERNAL ERROR: requesting blob from bool iterator" ); return nullptr; }
+	uint8_t *	GetPacked ( uint32_t tRowID, PackedArena_i & tArena ) final	{ assert ( 0 && "INTERNAL ERROR: requesting blob from bool iterator" ); return nullptr; }
+	void		FetchStrings ( const Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets ) final { assert ( 0 && "INTERNAL ERROR: requesting batch strings from bool iterator" ); }
+	void		FetchMva ( const Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets ) final { assert ( 0 && "INTERNAL ERROR: requesting batch MVA from bool iterator" ); }
 	int			GetLength ( uint32_t tRowID ) final						{ assert ( 0 && "INTERNAL ERROR: requesting string length from bool iterator" ); return 0; }
 
 	void		AddDesc ( std::vector<IteratorDesc_t> & dDesc ) const override { dDesc.push_back ( { BASE::m_tHeader.GetName(), "iterator" } ); };
 
 private:
 	FORCE_INLINE int64_t	DoGet ( uint32_t tRowID );
+
+	template <typename DST>
+	FORCE_INLINE void		DoFetch ( const Span_T<uint32_t> & dRowIDs, DST * pValue );
 };
 
 
 template <typename RD>
-void Iterator_Bool_T<RD>::Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues )
+template <typename DST>
+void Iterator_Bool_T<RD>::DoFetch ( const Span_T<uint32_t> & dRowIDs, DST * pValue )
 {
-	uint32_t * pRowID = dRowIDs.begin();
-	uint32_t * pRowIDEnd = dRowIDs.end();
-	int64_t * pValue = dValues.begin();
+	const uint32_t * pRowID = dRowIDs.begin();
+	const uint32_t * pRowIDEnd = dRowIDs.end();
+	int iSubblockShift = BASE::m_iSubblockShift;
+
 	while ( pRowID<pRowIDEnd )
-		*pValue++ = DoGet ( *pRowID++ );
+	{
+		uint32_t tRowID = *pRowID;
+		assert ( tRowID < BASE::m_tHeader.GetNumDocs() );
+
+		uint32_t uBlockId = RowId2BlockId(tRowID);
+		if ( uBlockId!=BASE::m_uBlockId )
+			BASE::SetCurBlock(uBlockId);
+
+		uint32_t uSubblock = tRowID >> iSubblockShift;
+		const uint32_t * pSubblockEnd = pRowID+1;
+		while ( pSubblockEnd<pRowIDEnd && ( *pSubblockEnd >> iSubblockShift )==uSubblock )
+			pSubblockEnd++;
+
+		if ( BASE::m_ePacking==BoolPacking_e::CONST )
+			std::fill ( pValue, pValue + ( pSubblockEnd-pRowID ), (DST)BASE::m_tBlockConst.GetValue() );
+		else if ( BASE::m_ePacking==BoolPacking_e::RLE )
+		{
+			for ( const uint32_t * p = pRowID; p<pSubblockEnd; p++ )
+				pValue[p-pRowID] = (DST)BASE::m_tBlockRLE.GetValue ( *p - BASE::m_tStartBlockRowId );
+		}
+		else
+		{
+			int iSubblockId = BASE::GetSubblockId ( tRowID - BASE::m_tStartBlockRowId );
+			BASE::m_tBlockBitmap.ReadSubblock ( iSubblockId, BASE::GetNumSubblockValues(iSubblockId), *BASE::m_pReader );
+			GatherValues ( BASE::m_tBlockBitmap.GetValues().data(), BASE::m_tStartBlockRowId + BASE::SubblockId2RowId(iSubblockId), pRowID, pSubblockEnd, pValue );
+		}
+
+		pValue += pSubblockEnd-pRowID;
+		pRowID = pSubblockEnd;
+	}
 }
 
 
@@ -231,6 +322,82 @@ int64_t Iterator_Bool_T<RD>::DoGet ( uint32_t tRowID )
 
 //////////////////////////////////////////////////////////////////////////
 
+template <typename RD=util::FileReader_c>
+class ScanCursor_Bool_T : public ScanCursor_i, public Accessor_Bool_T<RD>
+{
+	using BASE = Accessor_Bool_T<RD>;
+
+public:
+				ScanCursor_Bool_T ( const AttributeHeader_i & tHeader, RD * pReader, uint32_t tMinRowID, uint32_t tMaxRowID );
+
+	bool		GetNextSpan ( ScanSpan_t & tSpan ) final;
+	void		Reset ( uint32_t tMinRowID, uint32_t tMaxRowID ) final { m_tRowID = tMinRowID; m_tMaxRowID = std::min ( tMaxRowID, BASE::m_tHeader.GetNumDocs() ); }
+
+private:
+	uint32_t	m_tRowID = 0;
+	uint32_t	m_tMaxRowID = 0;
+};
+
+
+template <typename RD>
+ScanCursor_Bool_T<RD>::ScanCursor_Bool_T ( const AttributeHeader_i & tHeader, RD * pReader, uint32_t tMinRowID, uint32_t tMaxRowID )
+	: BASE ( tHeader, pReader )
+	, m_tRowID ( tMinRowID )
+	, m_tMaxRowID ( std::min ( tMaxRowID, tHeader.GetNumDocs() ) )
+{}
+
+
+template <typename RD>
+bool ScanCursor_Bool_T<RD>::GetNextSpan ( ScanSpan_t & tSpan )
+{
+	if ( m_tRowID>=m_tMaxRowID )
+		return false;
+
+	uint32_t uBlockId = RowId2BlockId(m_tRowID);
+	if ( uBlockId!=BASE::m_uBlockId )
+		BASE::SetCurBlock(uBlockId);
+
+	tSpan = ScanSpan_t();
+	tSpan.m_tRowID = m_tRowID;
+
+	if ( BASE::m_ePacking==BoolPacking_e::CONST )
+	{
+		uint32_t tBlockEnd = std::min ( BASE::m_tStartBlockRowId + BASE::m_uNumDocsInBlock, m_tMaxRowID );
+		tSpan.m_ePacking = ScanPacking_e::CONST;
+		tSpan.m_iValue = BASE::m_tBlockConst.GetValue();
+		tSpan.m_iNumValues = int ( tBlockEnd-m_tRowID );
+		m_tRowID = tBlockEnd;
+		return true;
+	}
+
+	if ( BASE::m_ePacking==BoolPacking_e::RLE )
+	{
+		int iRun = BASE::m_tBlockRLE.GetRuns().FindRun ( m_tRowID - BASE::m_tStartBlockRowId );
+		uint32_t tRunEnd = std::min ( BASE::m_tStartBlockRowId + BASE::m_tBlockRLE.GetRuns().GetRunEnd(iRun), m_tMaxRowID );
+		tSpan.m_ePacking = ScanPacking_e::CONST;
+		tSpan.m_iValue = BASE::m_tBlockRLE.GetRunValue(iRun);
+		tSpan.m_iNumValues = int ( tRunEnd-m_tRowID );
+		m_tRowID = tRunEnd;
+		return true;
+	}
+
+	uint32_t uIdInBlock = m_tRowID - BASE::m_tStartBlockRowId;
+	int iSubblockId = BASE::GetSubblockId(uIdInBlock);
+	int iNumValues = BASE::GetNumSubblockValues(iSubblockId);
+	int iStart = BASE::GetValueIdInSubblock(uIdInBlock);
+	uint32_t tSubblockStart = m_tRowID - iStart;
+	int iEnd = (int)std::min ( (uint32_t)iNumValues, m_tMaxRowID-tSubblockStart );
+
+	BASE::m_tBlockBitmap.ReadSubblock ( iSubblockId, iNumValues, *BASE::m_pReader );
+	SetScanValues ( tSpan, BASE::m_tBlockBitmap.GetValues(), iStart, iEnd );
+
+	tSpan.m_iNumValues = iEnd-iStart;
+	m_tRowID = tSubblockStart + iEnd;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 class AnalyzerBlock_Bool_Const_c
 {
 public:
@@ -288,6 +455,35 @@ int AnalyzerBlock_Bool_Bitmap_c::ProcessSubblock ( uint32_t * & pRowID, const Sp
 
 //////////////////////////////////////////////////////////////////////////
 
+class AnalyzerBlock_Bool_RLE_c
+{
+public:
+						AnalyzerBlock_Bool_RLE_c ( uint32_t & tRowID ) : m_tRowID ( tRowID ) {}
+
+	FORCE_INLINE int	ProcessSubblock ( uint32_t * & pRowID, StoredBlock_Bool_RLE_c & tBlock, uint32_t uStartInBlock, int iNumValues );
+	void				Setup ( bool bFilterValue ) { m_bFilterValue=bFilterValue; }
+
+private:
+	uint32_t &			m_tRowID;
+	bool				m_bFilterValue = false;
+};
+
+
+int AnalyzerBlock_Bool_RLE_c::ProcessSubblock ( uint32_t * & pRowID, StoredBlock_Bool_RLE_c & tBlock, uint32_t uStartInBlock, int iNumValues )
+{
+	tBlock.GetRuns().ForEachRun ( uStartInBlock, uStartInBlock+iNumValues, [this, &pRowID, &tBlock]( int iRun, uint32_t uRunStart, uint32_t uRunEnd )
+		{
+			if ( !!tBlock.GetRunValue(iRun)==m_bFilterValue )
+				FillWithIncreasingValues ( pRowID, uRunEnd-uRunStart, m_tRowID );
+			else
+				m_tRowID += uRunEnd-uRunStart;
+		} );
+
+	return iNumValues;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 template <bool HAVE_MATCHING_BLOCKS, typename RD=util::FileReader_c>
 class Analyzer_Bool_T : public Analyzer_T<HAVE_MATCHING_BLOCKS>, public Accessor_Bool_T<RD>
 {
@@ -306,6 +502,7 @@ private:
 
 	AnalyzerBlock_Bool_Const_c	m_tBlockConst;
 	AnalyzerBlock_Bool_Bitmap_c	m_tBlockBitmap;
+	AnalyzerBlock_Bool_RLE_c	m_tBlockRLE;
 
 	const Filter_t & m_tSettings;
 
@@ -318,6 +515,7 @@ private:
 
 	int			ProcessSubblockConst ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	int			ProcessSubblockBitmap ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int			ProcessSubblockRLE ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	int			ProcessSubblockAny ( uint32_t * & pRowID, int iSubblockIdInBlock )	{ return m_tBlockConst.ProcessSubblock ( pRowID, ACCESSOR::GetNumSubblockValues(iSubblockIdInBlock) ); }
 	int			ProcessSubblockNone ( uint32_t * & pRowID, int iSubblockIdInBlock )	{ return iSubblockIdInBlock; }
 
@@ -330,6 +528,7 @@ Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::Analyzer_Bool_T ( const AttributeHeade
 	, ACCESSOR ( tHeader, pReader )
 	, m_tBlockConst ( ANALYZER::m_tRowID )
 	, m_tBlockBitmap ( ANALYZER::m_tRowID )
+	, m_tBlockRLE ( ANALYZER::m_tRowID )
 	, m_tSettings ( tSettings )
 {
 	SetupPackingFuncs();
@@ -381,19 +580,23 @@ void Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::SetupPackingFuncs()
 	{
 		dFuncs[ to_underlying ( BoolPacking_e::CONST ) ] = &Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockAny;
 		dFuncs[ to_underlying ( BoolPacking_e::BITMAP) ] = &Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockAny;
+		dFuncs[ to_underlying ( BoolPacking_e::RLE) ] = &Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockAny;
 	}
 	else if ( !m_bAcceptFalse && !m_bAcceptTrue )
 	{
 		dFuncs [ to_underlying ( BoolPacking_e::CONST  ) ] = &Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockNone;
 		dFuncs [ to_underlying ( BoolPacking_e::BITMAP ) ] = &Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockNone;
+		dFuncs [ to_underlying ( BoolPacking_e::RLE ) ] = &Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockNone;
 	}
 	else
 	{
 		dFuncs [ to_underlying ( BoolPacking_e::CONST  ) ] = &Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockConst;
 		dFuncs [ to_underlying ( BoolPacking_e::BITMAP ) ] = &Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockBitmap;
+		dFuncs [ to_underlying ( BoolPacking_e::RLE ) ] = &Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockRLE;
 
 		m_tBlockConst.Setup(m_bAcceptTrue);
 		m_tBlockBitmap.Setup(m_bAcceptTrue);
+		m_tBlockRLE.Setup(m_bAcceptTrue);
 	}
 }
 
@@ -410,6 +613,12 @@ int Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockBitmap ( uint32_t *
 	return m_tBlockBitmap.ProcessSubblock ( pRowID, ACCESSOR::m_tBlockBitmap.GetValues() );
 }
 
+template <bool HAVE_MATCHING_BLOCKS, typename RD>
+int Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockRLE ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	return m_tBlockRLE.ProcessSubblock ( pRowID, ACCESSOR::m_tBlockRLE, StoredBlockTraits_t::SubblockId2RowId(iSubblockIdInBlock), StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock) );
+}
+
 template <bool HAVE_MATCHING_BLOCKS, typename RD>
 bool Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::GetNextRowIdBlock ( Span_T<uint32_t> & dRowIdBlock )
 {
@@ -448,6 +657,8 @@ bool Analyzer_Bool_T<HAVE_MATCHING_BLOCKS,RD>::MoveToBlock ( int iNextBlock )
 
 Iterator_i * CreateIteratorBool ( const AttributeHeader_i & tHeader, FileReader_c * pReader )		{ return new Iterator_Bool_T<FileReader_c> ( tHeader, pReader ); }
 Iterator_i * CreateIteratorBool ( const AttributeHeader_i & tHeader, MappedReader_c * pReader )		{ return new Iterator_Bool_T<MappedReader_c> ( tHeader, pReader ); }
+ScanCursor_i * CreateScanCursorBool ( const AttributeHeader_i & tHeader, FileReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID )		{ return new ScanCursor_Bool_T<FileReader_c> ( tHeader, pReader, tMinRowID, tMaxRowID ); }
+ScanCursor_i * CreateScanCursorBool ( const AttributeHeader_i & tHeader, MappedReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID )	{ return new ScanCursor_Bool_T<MappedReader_c> ( tHeader, pReader, tMinRowID, tMaxRowID ); }
 
 
 template <typename RD>
@@ -477,7 +688,7 @@ private:
 bool Checker_Bool_c::CheckBlockHeader ( uint32_t uBlockId )
 {
 	uint32_t uPacking = m_pReader->Unpack_uint32();
-	if ( uPacking!=(uint32_t)BoolPacking_e::CONST && uPacking!=(uint32_t)BoolPacking_e::BITMAP )
+	if ( uPacking!=(uint32_t)BoolPacking_e::CONST && uPacking!=(uint32_t)BoolPacking_e::BITMAP && uPacking!=(uint32_t)BoolPacking_e::RLE )
 	{
 		m_fnError ( FormatStr ( "Unknown encoding of block %u: %u", uBlockId, uPacking ).c_str() );
 		return false;
@@ -29,11 +29,14 @@ namespace columnar
 {
 
 class Iterator_i;
+class ScanCursor_i;
 class Analyzer_i;
 class AttributeHeader_i;
 
 Iterator_i *	CreateIteratorBool ( const AttributeHeader_i & tHeader, util::FileReader_c * pReader );
 Iterator_i *	CreateIteratorBool ( const AttributeHeader_i & tHeader, util::MappedReader_c * pReader );
+ScanCursor_i *	CreateScanCursorBool ( const AttributeHeader_i & tHeader, util::FileReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID );
+ScanCursor_i *	CreateScanCursorBool ( const AttributeHeader_i & tHeader, util::MappedReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID );
 Analyzer_i *	CreateAnalyzerBool ( const AttributeHeader_i & tHeader, util::FileReader_c * pReader, const common::Filter_t & tSettings, bool bHaveMatchingBlocks );
 Analyzer_i *	CreateAnalyzerBool ( const AttributeHeader_i & tHeader, util::MappedReader_c * pReader, const common::Filter_t & tSettings, bool bHaveMatchingBlocks );
 Checker_i *		CreateCheckerBool ( const AttributeHeader_i & tHeader, util::FileReader_c * pReader, Reporter_fn & fnProgress, Reporter_fn & fnError );
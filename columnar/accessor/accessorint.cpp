@@ -21,9 +21,11 @@
 #include "interval.h"
 #include "reader.h"
 #include "check.h"
+#include "subblockcache.h"
 
 #include <algorithm>
 #include <tuple>
+#include <unordered_map>
 
 namespace columnar
 {
@@ -136,22 +138,64 @@ int StoredBlock_Int_Table_T<T>::GetIndexInTable ( T tValue ) const
 
 //////////////////////////////////////////////////////////////////////////
 
+template <typename T>
+class StoredBlock_Int_RLE_T
+{
+public:
+							StoredBlock_Int_RLE_T ( const std::string & sCodec32, const std::string & sCodec64 );
+
+	template <typename RD> FORCE_INLINE void ReadHeader ( RD & tReader );
+	FORCE_INLINE T			GetValue ( uint32_t uIdInBlock )	{ return m_dRunValues [ m_tRuns.FindRun(uIdInBlock) ]; }
+	FORCE_INLINE T			GetRunValue ( int iRun ) const		{ return m_dRunValues[iRun]; }
+	FORCE_INLINE BlockRuns_c & GetRuns()						{ return m_tRuns; }
+
+private:
+	IntCodecPooledPtr_t		m_pCodec;
+	SpanResizeable_T<T>		m_dRunValues;
+	SpanResizeable_T<uint32_t> m_dTmp;
+	BlockRuns_c				m_tRuns;
+};
+
+template <typename T>
+StoredBlock_Int_RLE_T<T>::StoredBlock_Int_RLE_T ( const std::string & sCodec32, const std::string & sCodec64 )
+	: m_pCodec ( CreateIntCodec ( sCodec32, sCodec64 ) )
+{}
+
+template <typename T>
+template <typename RD>
+void StoredBlock_Int_RLE_T<T>::ReadHeader ( RD & tReader )
+{
+	int iNumRuns = (int)tReader.Unpack_uint32();
+	m_dRunValues.resize(iNumRuns);
+
+	uint32_t uTotalSize = tReader.Unpack_uint32();
+	DecodeValues_PFOR ( m_dRunValues, tReader, *m_pCodec, m_dTmp, uTotalSize );
+	m_tRuns.Read ( tReader, iNumRuns, *m_pCodec );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 template <typename T>
 class StoredBlock_Int_PFOR_T
 {
 public:
-							StoredBlock_Int_PFOR_T ( const std::string & sCodec32, const std::string & sCodec64, uint32_t uVersion );
+							StoredBlock_Int_PFOR_T ( const std::string & sCodec32, const std::string & sCodec64, uint32_t uVersion, SubblockCache_c * pCache, const AttributeHeader_i * pHeader );
 
-	template <typename RD> FORCE_INLINE void ReadHeader ( RD & tReader, int iNumSubblocks );
+	template <typename RD> FORCE_INLINE void ReadHeader ( RD & tReader, int iNumSubblocks, uint32_t uBlockId );
 	template <typename RD> FORCE_INLINE void ReadSubblock_Delta ( int iSubblockId, int iNumValues, RD & tReader );
 	template <typename RD> FORCE_INLINE void ReadSubblock_Generic ( int iSubblockId, int iNumValues, RD & tReader );
 	template <typename RD> FORCE_INLINE void ReadSubblock_Hash ( int iSubblockId, int iNumValues, RD & tReader );
+	template <typename RD> FORCE_INLINE void ReadSubblock_Float ( int iSubblockId, int iNumValues, RD & tReader );
 	FORCE_INLINE T			GetValue ( int iIdInSubblock ) const;
-	FORCE_INLINE const Span_T<T> & GetAllValues() const { return m_dSubblockValues; }
+	FORCE_INLINE const Span_T<const T> & GetAllValues() const { return m_dValues; }
 
 private:
 	IntCodecPooledPtr_t			m_pCodec;
+	SubblockCodecs_c			m_tCodecs;
 	uint32_t					m_uVersion = 0;
+	SubblockCache_c *			m_pCache = nullptr;
+	const AttributeHeader_i *	m_pHeader = nullptr;
+	uint32_t					m_uBlockId = 0;
 	SpanResizeable_T<uint32_t>	m_dSubblockCumulativeSizes;
 	SpanResizeable_T<uint32_t>	m_dTmp;
 	SpanResizeable_T<uint64_t>	m_dTmp64;
@@ -159,7 +203,10 @@ private:
 	int64_t						m_tValuesOffset = 0;
 
 	int							m_iSubblockId = -1;
+	int							m_iDecodedSubblockId = -1;	// the subblock currently held in m_dSubblockValues
 	SpanResizeable_T<T>			m_dSubblockValues;
+	std::shared_ptr<const std::vector<T>> m_pCachedValues;
+	Span_T<const T>				m_dValues;			// points either to m_dSubblockValues or to a cached subblock; cached subblocks are shared, so this is read-only
 
 	template <typename RD, typename DECOMPRESS>
 	FORCE_INLINE void		ReadSubblock ( int iSubblockId, int iNumValues, RD & tReader, DECOMPRESS && fnDecompress );
@@ -168,30 +215,36 @@ private:
 };
 
 template <typename T>
-StoredBlock_Int_PFOR_T<T>::StoredBlock_Int_PFOR_T ( const std::string & sCodec32, const std::string & sCodec64, uint32_t uVersion )
+StoredBlock_Int_PFOR_T<T>::StoredBlock_Int_PFOR_T ( const std::string & sCodec32, const std::string & sCodec64, uint32_t uVersion, SubblockCache_c * pCache, const AttributeHeader_i * pHeader )
 	: m_pCodec ( CreateIntCodec ( sCodec32, sCodec64 ) )
+	, m_tCodecs ( sCodec32, sCodec64, uVersion )
 	, m_uVersion ( uVersion )
+	, m_pCache ( pCache )
+	, m_pHeader ( pHeader )
 {}
 
 template <typename T>
 template <typename RD>
-void StoredBlock_Int_PFOR_T<T>::ReadHeader ( RD & tReader, int iNumSubblocks )
+void StoredBlock_Int_PFOR_T<T>::ReadHeader ( RD & tReader, int iNumSubblocks, uint32_t uBlockId )
 {
+	m_uBlockId = uBlockId;
 	m_dSubblockCumulativeSizes.resize(iNumSubblocks);
 
 	uint32_t uSubblockSize = tReader.Unpack_uint32();
 	DecodeValues_Delta_PFOR ( m_dSubblockCumulativeSizes, tReader, *m_pCodec, m_dTmp, uSubblockSize, false, m_uVersion );
+	m_tCodecs.ReadHeader ( tReader, iNumSubblocks );
 
 	m_tValuesOffset = tReader.GetPos();
 	m_iSubblockId = -1;
+	m_iDecodedSubblockId = -1;
 }
 
 template <typename T>
 template <typename RD>
 void StoredBlock_Int_PFOR_T<T>::ReadSubblock_Delta ( int iSubblockId, int iNumValues, RD & tReader )
 {
-	ReadSubblock ( iSubblockId, iNumValues, tReader, [this] ( SpanResizeable_T<T> & dValues, auto & tReader, uint32_t uTotalSize )
-		{ DecodeValues_Delta_PFOR ( dValues, tReader, *m_pCodec, m_dTmp, uTotalSize, true, m_uVersion ); }
+	ReadSubblock ( iSubblockId, iNumValues, tReader, [this,iSubblockId] ( SpanResizeable_T<T> & dValues, auto & tReader, uint32_t uTotalSize )
+		{ DecodeValues_Delta_PFOR ( dValues, tReader, m_tCodecs.Get(iSubblockId), m_dTmp, uTotalSize, true, m_uVersion ); }
 	);
 }
 
@@ -199,8 +252,8 @@ template <typename T>
 template <typename RD>
 void StoredBlock_Int_PFOR_T<T>::ReadSubblock_Generic ( int iSubblockId, int iNumValues, RD & tReader )
 {
-	ReadSubblock ( iSubblockId, iNumValues, tReader, [this] ( SpanResizeable_T<T> & dValues, auto & tReader, uint32_t uTotalSize )
-		{ DecodeValues_PFOR ( dValues, tReader, *m_pCodec, m_dTmp, uTotalSize ); }
+	ReadSubblock ( iSubblockId, iNumValues, tReader, [this,iSubblockId] ( SpanResizeable_T<T> & dValues, auto & tReader, uint32_t uTotalSize )
+		{ DecodeValues_PFOR ( dValues, tReader, m_tCodecs.Get(iSubblockId), m_dTmp, uTotalSize ); }
 	);
 }
 
@@ -213,6 +266,15 @@ void StoredBlock_Int_PFOR_T<T>::ReadSubblock_Hash ( int iSubblockId, int iNumVal
 	);
 }
 
+template <typename T>
+template <typename RD>
+void StoredBlock_Int_PFOR_T<T>::ReadSubblock_Float ( int iSubblockId, int iNumValues, RD & tReader )
+{
+	ReadSubblock ( iSubblockId, iNumValues, tReader, [this,iSubblockId] ( SpanResizeable_T<T> & dValues, auto & tReader, uint32_t uTotalSize )
+		{ DecodeValues_Float ( dValues, tReader, m_tCodecs.Get(iSubblockId), m_dTmp, uTotalSize ); }
+	);
+}
+
 template <typename T>
 template <typename RD, typename DECOMPRESS>
 void StoredBlock_Int_PFOR_T<T>::ReadSubblock ( int iSubblockId, int iNumValues, RD & tReader, DECOMPRESS && fnDecompress )
@@ -222,6 +284,24 @@ void StoredBlock_Int_PFOR_T<T>::ReadSubblock ( int iSubblockId, int iNumValues,
 
 	m_iSubblockId = iSubblockId;
 
+	// decoded by this accessor earlier and still around; no need to go to the shared cache
+	if ( m_iDecodedSubblockId==iSubblockId )
+	{
+		m_dValues = { m_dSubblockValues.data(), m_dSubblockValues.size() };
+		m_pCachedValues.reset();
+		return;
+	}
+
+	if ( m_pCache )
+	{
+		m_pCachedValues = m_pCache->Get<T> ( m_pHeader, m_uBlockId, iSubblockId );
+		if ( m_pCachedValues )
+		{
+			m_dValues = { m_pCachedValues->data(), m_pCachedValues->size() };
+			return;
+		}
+	}
+
 	uint32_t uSize = m_dSubblockCumulativeSizes[iSubblockId];
 	uint32_t uOffset = 0;
 	if ( iSubblockId>0 )
@@ -233,12 +313,19 @@ void StoredBlock_Int_PFOR_T<T>::ReadSubblock ( int iSubblockId, int iNumValues,
 	m_dSubblockValues.resize(iNumValues);
 	tReader.Seek ( m_tValuesOffset+uOffset );
 	fnDecompress ( m_dSubblockValues, tReader, uSize );
+	m_iDecodedSubblockId = iSubblockId;
+	m_dValues = { m_dSubblockValues.data(), m_dSubblockValues.size() };
+	m_pCachedValues.reset();
+
+	// the cache gets its own copy; m_dSubblockValues is reused for the next subblock
+	if ( m_pCache )
+		m_pCache->Add ( m_pHeader, m_uBlockId, iSubblockId, Span_T<T> ( m_dSubblockValues ) );
 }
 
 template <typename T>
 T StoredBlock_Int_PFOR_T<T>::GetValue ( int iIdInSubblock ) const
 {
-	return m_dSubblockValues[iIdInSubblock];
+	return m_dValues[iIdInSubblock];
 }
 
 template <typename T>
@@ -290,7 +377,11 @@ template<typename T, typename RD=util::FileReader_c>
 class Accessor_INT_T : public StoredBlockTraits_t
 {
 public:
-					Accessor_INT_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader );
+					Accessor_INT_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, RD * pReader );
+					~Accessor_INT_T() { UpdateCounters ( *m_pReader, m_tHeader, 0 ); }
+
+	FORCE_INLINE void	PrefetchBlock ( int iBlock ) const	{ PrefetchBlockData ( *m_pReader, m_tHeader, iBlock ); }
+	FORCE_INLINE int	GetNumBlocks() const				{ return m_tHeader.GetNumBlocks(); }
 
 protected:
 	const AttributeHeader_i &		m_tHeader;
@@ -299,6 +390,7 @@ protected:
 	StoredBlock_Int_Const_T<T>		m_tBlockConst;
 	StoredBlock_Int_Table_T<T>		m_tBlockTable;
 	StoredBlock_Int_PFOR_T<T>		m_tBlockPFOR;
+	StoredBlock_Int_RLE_T<T>		m_tBlockRLE;
 
 	int64_t (Accessor_INT_T<T,RD>::*m_fnReadValue)() = nullptr;
 
@@ -311,15 +403,18 @@ protected:
 	int64_t			ReadValue_Delta();
 	int64_t			ReadValue_Generic();
 	int64_t			ReadValue_Hash();
+	int64_t			ReadValue_Float();
+	int64_t			ReadValue_RLE();
 };
 
 template<typename T, typename RD>
-Accessor_INT_T<T,RD>::Accessor_INT_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader )
+Accessor_INT_T<T,RD>::Accessor_INT_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, RD * pReader )
 	: StoredBlockTraits_t ( tHeader.GetSettings().m_iSubblockSize )
 	, m_tHeader ( tHeader )
 	, m_pReader ( pReader )
 	, m_tBlockTable ( tHeader.GetSettings().m_iSubblockSize, tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64, uVersion )
-	, m_tBlockPFOR ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64, uVersion )
+	, m_tBlockPFOR ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64, uVersion, pCache, &tHeader )
+	, m_tBlockRLE ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64 )
 {
 	assert(pReader);
 }
@@ -327,6 +422,7 @@ Accessor_INT_T<T,RD>::Accessor_INT_T ( const AttributeHeader_i & tHeader, uint32
 template<typename T, typename RD>
 void Accessor_INT_T<T,RD>::SetCurBlock ( uint32_t uBlockId )
 {
+	UpdateCounters ( *m_pReader, m_tHeader, 1 );
 	m_pReader->Seek ( m_tHeader.GetBlockOffset(uBlockId) );
 	m_ePacking = (IntPacking_e)m_pReader->Unpack_uint32();
 
@@ -347,17 +443,27 @@ void Accessor_INT_T<T,RD>::SetCurBlock ( uint32_t uBlockId )
 
 	case IntPacking_e::DELTA:
 		m_fnReadValue = &Accessor_INT_T<T,RD>::ReadValue_Delta;
-		m_tBlockPFOR.ReadHeader ( *m_pReader, m_iNumSubblocks );
+		m_tBlockPFOR.ReadHeader ( *m_pReader, m_iNumSubblocks, uBlockId );
 		break;
 
 	case IntPacking_e::GENERIC:
 		m_fnReadValue = &Accessor_INT_T<T,RD>::ReadValue_Generic;
-		m_tBlockPFOR.ReadHeader ( *m_pReader, m_iNumSubblocks );
+		m_tBlockPFOR.ReadHeader ( *m_pReader, m_iNumSubblocks, uBlockId );
 		break;
 
 	case IntPacking_e::HASH:
 		m_fnReadValue = &Accessor_INT_T<T,RD>::ReadValue_Hash;
-		m_tBlockPFOR.ReadHeader ( *m_pReader, m_iNumSubblocks );
+		m_tBlockPFOR.ReadHeader ( *m_pReader, m_iNumSubblocks, uBlockId );
+		break;
+
+	case IntPacking_e::FLOAT:
+		m_fnReadValue = &Accessor_INT_T<T,RD>::ReadValue_Float;
+		m_tBlockPFOR.ReadHeader ( *m_pReader, m_iNumSubblocks, uBlockId );
+		break;
+
+	case IntPacking_e::RLE:
+		m_fnReadValue = &Accessor_INT_T<T,RD>::ReadValue_RLE;
+		m_tBlockRLE.ReadHeader ( *m_pReader );
 		break;
 
 	default:
@@ -407,6 +513,21 @@ int64_t Accessor_INT_T<T,RD>::ReadValue_Hash()
 	return m_tBlockPFOR.GetValue ( GetValueIdInSubblock(uIdInBlock) );
 }
 
+template<typename T, typename RD>
+int64_t Accessor_INT_T<T,RD>::ReadValue_Float()
+{
+	uint32_t uIdInBlock = m_tRequestedRowID - m_tStartBlockRowId;
+	int iSubblockId = GetSubblockId(uIdInBlock);
+	m_tBlockPFOR.ReadSubblock_Float ( iSubblockId, StoredBlockTraits_t::GetNumSubblockValues(iSubblockId), *m_pReader );
+	return m_tBlockPFOR.GetValue ( GetValueIdInSubblock(uIdInBlock) );
+}
+
+template<typename T, typename RD>
+int64_t Accessor_INT_T<T,RD>::ReadValue_RLE()
+{
+	return m_tBlockRLE.GetValue ( m_tRequestedRowID - m_tStartBlockRowId );
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 template<typename T, typename RD=util::FileReader_c>
@@ -417,26 +538,152 @@ class Iterator_INT_T : public Iterator_i, public Accessor_INT_T<T,RD>
 
 public:
 	int64_t		Get ( uint32_t tRowID ) final			{ return DoGet(tRowID); }
-	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final;
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final	{ DoFetch ( dRowIDs, dValues.data() ); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<uint32_t> & dValues ) final;
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<uint8_t> & dValues ) final	{ FetchConverted ( dRowIDs, dValues.data(), []( int64_t iValue ){ return uint8_t ( iValue!=0 ); } ); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<float> & dValues ) final;
 
 	int			Get ( uint32_t tRowID, const uint8_t * & pData ) final	{ assert ( 0 && "INTERNAL ERROR: requesting blob from int iterator" ); return 0; }
 	uint8_t *	GetPacked ( uint32_t tRowID ) final						{ assert ( 0 && "INTERNAL ERROR: requesting blob from int iterator" ); return nullptr; }
+	uint8_t *	GetPacked ( uint32_t tRowID, PackedArena_i & tArena ) final	{ assert ( 0 && "INTERNAL ERROR: requesting blob from int iterator" ); return nullptr; }
+	void		FetchStrings ( const Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets ) final { assert ( 0 && "INTERNAL ERROR: requesting batch strings from int iterator" ); }
+	void		FetchMva ( const Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets ) final { assert ( 0 && "INTERNAL ERROR: requesting batch MVA from int iterator" ); }
 	int			GetLength ( uint32_t tRowID ) final						{ assert ( 0 && "INTERNAL ERROR: requesting blob length from int iterator" ); return 0; }
 
 	void		AddDesc ( std::vector<IteratorDesc_t> & dDesc ) const override { dDesc.push_back ( { BASE::m_tHeader.GetName(), "iterator" } ); };
 
 private:
+	std::vector<int64_t>	m_dConverted;	// scratch for typed fetches that need a conversion
+
 	FORCE_INLINE int64_t DoGet ( uint32_t tRowID );
+
+	template <typename DST>
+	FORCE_INLINE void	DoFetch ( const Span_T<uint32_t> & dRowIDs, DST * pValue );
+
+	template <typename DST, typename CONVERT>
+	void				FetchConverted ( const Span_T<uint32_t> & dRowIDs, DST * pValue, CONVERT && fnConvert );
+
+	template <typename DST>
+	FORCE_INLINE DST *	FetchSubblock ( const uint32_t * pRowID, const uint32_t * pRowIDEnd, DST * pValue );
 };
 
 template<typename T, typename RD>
-void Iterator_INT_T<T,RD>::Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues )
+void Iterator_INT_T<T,RD>::Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<uint32_t> & dValues )
 {
-	uint32_t * pRowID = dRowIDs.begin();
-	uint32_t * pRowIDEnd = dRowIDs.end();
-	int64_t * pValue = dValues.begin();
+	if ( sizeof(T)==sizeof(uint32_t) )
+	{
+		DoFetch ( dRowIDs, dValues.data() );
+		return;
+	}
+
+	// 64-bit values are clamped to the uint32 range instead of being truncated
+	FetchConverted ( dRowIDs, dValues.data(), []( int64_t iValue ){ return (uint32_t)std::min<int64_t> ( std::max<int64_t> ( iValue, 0 ), UINT32_MAX ); } );
+}
+
+template<typename T, typename RD>
+void Iterator_INT_T<T,RD>::Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<float> & dValues )
+{
+	// FLOAT columns store the bit representation of the value, so no conversion is needed
+	if ( sizeof(T)==sizeof(float) && BASE::m_tHeader.GetType()==AttrType_e::FLOAT )
+	{
+		DoFetch ( dRowIDs, (uint32_t*)dValues.data() );
+		return;
+	}
+
+	FetchConverted ( dRowIDs, dValues.data(), []( int64_t iValue ){ return (float)iValue; } );
+}
+
+template<typename T, typename RD>
+template <typename DST, typename CONVERT>
+void Iterator_INT_T<T,RD>::FetchConverted ( const Span_T<uint32_t> & dRowIDs, DST * pValue, CONVERT && fnConvert )
+{
+	m_dConverted.resize ( dRowIDs.size() );
+	DoFetch ( dRowIDs, m_dConverted.data() );
+	for ( auto i : m_dConverted )
+		*pValue++ = fnConvert(i);
+}
+
+template<typename T, typename RD>
+template <typename DST>
+void Iterator_INT_T<T,RD>::DoFetch ( const Span_T<uint32_t> & dRowIDs, DST * pValue )
+{
+	const uint32_t * pRowID = dRowIDs.begin();
+	const uint32_t * pRowIDEnd = dRowIDs.end();
+	int iSubblockShift = BASE::m_iSubblockShift;
+
 	while ( pRowID<pRowIDEnd )
-		*pValue++ = DoGet ( *pRowID++ );
+	{
+		uint32_t tRowID = *pRowID;
+		assert ( tRowID < BASE::m_tHeader.GetNumDocs() );
+
+		uint32_t uBlockId = RowId2BlockId(tRowID);
+		if ( uBlockId!=BASE::m_uBlockId )
+			BASE::SetCurBlock(uBlockId);
+
+		// rowids are usually sorted, so we decode each subblock once and fetch all its rowids in one go
+		uint32_t uSubblock = tRowID >> iSubblockShift;
+		const uint32_t * pSubblockEnd = pRowID+1;
+		while ( pSubblockEnd<pRowIDEnd && ( *pSubblockEnd >> iSubblockShift )==uSubblock )
+			pSubblockEnd++;
+
+		pValue = FetchSubblock ( pRowID, pSubblockEnd, pValue );
+		pRowID = pSubblockEnd;
+	}
+}
+
+template<typename T, typename RD>
+template <typename DST>
+DST * Iterator_INT_T<T,RD>::FetchSubblock ( const uint32_t * pRowID, const uint32_t * pRowIDEnd, DST * pValue )
+{
+	uint32_t uIdInBlock = *pRowID - BASE::m_tStartBlockRowId;
+	int iSubblockId = BASE::GetSubblockId(uIdInBlock);
+	int iNumValues = BASE::GetNumSubblockValues(iSubblockId);
+	uint32_t tSubblockStart = BASE::m_tStartBlockRowId + BASE::SubblockId2RowId(iSubblockId);
+	auto & tBlockPFOR = BASE::m_tBlockPFOR;
+
+	switch ( BASE::m_ePacking )
+	{
+	case IntPacking_e::CONST:
+		std::fill ( pValue, pValue + ( pRowIDEnd-pRowID ), (DST)BASE::m_tBlockConst.GetValue() );
+		break;
+
+	case IntPacking_e::TABLE:
+		BASE::m_tBlockTable.ReadSubblock ( iSubblockId, iNumValues, *BASE::m_pReader );
+		for ( const uint32_t * p = pRowID; p<pRowIDEnd; p++ )
+			pValue[p-pRowID] = (DST)BASE::m_tBlockTable.GetValue ( *p - tSubblockStart );
+		break;
+
+	case IntPacking_e::DELTA:
+		tBlockPFOR.ReadSubblock_Delta ( iSubblockId, iNumValues, *BASE::m_pReader );
+		GatherValues ( tBlockPFOR.GetAllValues().data(), tSubblockStart, pRowID, pRowIDEnd, pValue );
+		break;
+
+	case IntPacking_e::GENERIC:
+		tBlockPFOR.ReadSubblock_Generic ( iSubblockId, iNumValues, *BASE::m_pReader );
+		GatherValues ( tBlockPFOR.GetAllValues().data(), tSubblockStart, pRowID, pRowIDEnd, pValue );
+		break;
+
+	case IntPacking_e::HASH:
+		tBlockPFOR.ReadSubblock_Hash ( iSubblockId, iNumValues, *BASE::m_pReader );
+		GatherValues ( tBlockPFOR.GetAllValues().data(), tSubblockStart, pRowID, pRowIDEnd, pValue );
+		break;
+
+	case IntPacking_e::FLOAT:
+		tBlockPFOR.ReadSubblock_Float ( iSubblockId, iNumValues, *BASE::m_pReader );
+		GatherValues ( tBlockPFOR.GetAllValues().data(), tSubblockStart, pRowID, pRowIDEnd, pValue );
+		break;
+
+	case IntPacking_e::RLE:
+		for ( const uint32_t * p = pRowID; p<pRowIDEnd; p++ )
+			pValue[p-pRowID] = (DST)BASE::m_tBlockRLE.GetValue ( *p - BASE::m_tStartBlockRowId );
+		break;
+
+	default:
+		assert ( 0 && "Packing not implemented yet" );
+		break;
+	}
+
+	return pValue + ( pRowIDEnd-pRowID );
 }
 
 template<typename T, typename RD>
@@ -456,6 +703,265 @@ int64_t Iterator_INT_T<T,RD>::DoGet ( uint32_t tRowID )
 
 //////////////////////////////////////////////////////////////////////////
 
+template<typename T, typename RD=util::FileReader_c>
+class ScanCursor_INT_T : public ScanCursor_i, public Accessor_INT_T<T,RD>
+{
+	using BASE = Accessor_INT_T<T,RD>;
+
+public:
+				ScanCursor_INT_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, RD * pReader, uint32_t tMinRowID, uint32_t tMaxRowID );
+
+	bool		GetNextSpan ( ScanSpan_t & tSpan ) final;
+	void		Reset ( uint32_t tMinRowID, uint32_t tMaxRowID ) final { m_tRowID = tMinRowID; m_tMaxRowID = std::min ( tMaxRowID, BASE::m_tHeader.GetNumDocs() ); m_iPrefetchedBlock = -1; }
+
+private:
+	uint32_t				m_tRowID = 0;
+	uint32_t				m_tMaxRowID = 0;
+	int						m_iPrefetchedBlock = -1;
+	std::vector<int64_t>	m_dTable;
+
+	void		PrefetchBlocks ( int iBlock );
+};
+
+template<typename T, typename RD>
+ScanCursor_INT_T<T,RD>::ScanCursor_INT_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, RD * pReader, uint32_t tMinRowID, uint32_t tMaxRowID )
+	: BASE ( tHeader, uVersion, pCache, pReader )
+	, m_tRowID ( tMinRowID )
+	, m_tMaxRowID ( std::min ( tMaxRowID, tHeader.GetNumDocs() ) )
+{}
+
+template<typename T, typename RD>
+void ScanCursor_INT_T<T,RD>::PrefetchBlocks ( int iBlock )
+{
+	int iLastBlock = (int)RowId2BlockId ( m_tMaxRowID-1 );
+	for ( int i = std::max ( iBlock, m_iPrefetchedBlock+1 ); i < iBlock+PREFETCH_BLOCKS && i<=iLastBlock; i++ )
+	{
+		BASE::PrefetchBlock(i);
+		m_iPrefetchedBlock = i;
+	}
+}
+
+template<typename T, typename RD>
+bool ScanCursor_INT_T<T,RD>::GetNextSpan ( ScanSpan_t & tSpan )
+{
+	if ( m_tRowID>=m_tMaxRowID )
+		return false;
+
+	uint32_t uBlockId = RowId2BlockId(m_tRowID);
+	if ( uBlockId!=BASE::m_uBlockId )
+	{
+		PrefetchBlocks(uBlockId);
+		BASE::SetCurBlock(uBlockId);
+
+		// the table is small, so we convert it once per block and pass the decoded indexes as is
+		if ( BASE::m_ePacking==IntPacking_e::TABLE )
+		{
+			m_dTable.resize ( BASE::m_tBlockTable.GetTableSize() );
+			for ( size_t i = 0; i < m_dTable.size(); i++ )
+				m_dTable[i] = (int64_t)BASE::m_tBlockTable.GetValueFromTable ( (uint8_t)i );
+		}
+	}
+
+	tSpan = ScanSpan_t();
+	tSpan.m_tRowID = m_tRowID;
+
+	// const blocks are returned whole, without going through subblocks
+	if ( BASE::m_ePacking==IntPacking_e::CONST )
+	{
+		uint32_t tBlockEnd = std::min ( BASE::m_tStartBlockRowId + BASE::m_uNumDocsInBlock, m_tMaxRowID );
+		tSpan.m_ePacking = ScanPacking_e::CONST;
+		tSpan.m_iValue = (int64_t)BASE::m_tBlockConst.GetValue();
+		tSpan.m_iNumValues = int ( tBlockEnd-m_tRowID );
+		m_tRowID = tBlockEnd;
+		return true;
+	}
+
+	// same for every run of an RLE block
+	if ( BASE::m_ePacking==IntPacking_e::RLE )
+	{
+		auto & tBlockRLE = BASE::m_tBlockRLE;
+		int iRun = tBlockRLE.GetRuns().FindRun ( m_tRowID - BASE::m_tStartBlockRowId );
+		uint32_t tRunEnd = std::min ( BASE::m_tStartBlockRowId + tBlockRLE.GetRuns().GetRunEnd(iRun), m_tMaxRowID );
+		tSpan.m_ePacking = ScanPacking_e::CONST;
+		tSpan.m_iValue = (int64_t)tBlockRLE.GetRunValue(iRun);
+		tSpan.m_iNumValues = int ( tRunEnd-m_tRowID );
+		m_tRowID = tRunEnd;
+		return true;
+	}
+
+	uint32_t uIdInBlock = m_tRowID - BASE::m_tStartBlockRowId;
+	int iSubblockId = BASE::GetSubblockId(uIdInBlock);
+	int iNumValues = BASE::GetNumSubblockValues(iSubblockId);
+	int iStart = BASE::GetValueIdInSubblock(uIdInBlock);
+	uint32_t tSubblockStart = m_tRowID - iStart;
+	int iEnd = (int)std::min ( (uint32_t)iNumValues, m_tMaxRowID-tSubblockStart );
+	auto & tBlockPFOR = BASE::m_tBlockPFOR;
+
+	switch ( BASE::m_ePacking )
+	{
+	case IntPacking_e::TABLE:
+		BASE::m_tBlockTable.ReadSubblock ( iSubblockId, iNumValues, *BASE::m_pReader );
+		tSpan.m_ePacking = ScanPacking_e::TABLE;
+		tSpan.m_dTable = Span_T<int64_t>(m_dTable);
+		tSpan.m_dIndexes = { BASE::m_tBlockTable.GetValueIndexes().data()+iStart, size_t(iEnd-iStart) };
+		break;
+
+	case IntPacking_e::DELTA:
+		tBlockPFOR.ReadSubblock_Delta ( iSubblockId, iNumValues, *BASE::m_pReader );
+		SetScanValues ( tSpan, tBlockPFOR.GetAllValues(), iStart, iEnd );
+		break;
+
+	case IntPacking_e::GENERIC:
+		tBlockPFOR.ReadSubblock_Generic ( iSubblockId, iNumValues, *BASE::m_pReader );
+		SetScanValues ( tSpan, tBlockPFOR.GetAllValues(), iStart, iEnd );
+		break;
+
+	case IntPacking_e::HASH:
+		tBlockPFOR.ReadSubblock_Hash ( iSubblockId, iNumValues, *BASE::m_pReader );
+		SetScanValues ( tSpan, tBlockPFOR.GetAllValues(), iStart, iEnd );
+		break;
+
+	case IntPacking_e::FLOAT:
+		tBlockPFOR.ReadSubblock_Float ( iSubblockId, iNumValues, *BASE::m_pReader );
+		SetScanValues ( tSpan, tBlockPFOR.GetAllValues(), iStart, iEnd );
+		break;
+
+	default:
+		assert ( 0 && "Packing not implemented yet" );
+		return false;
+	}
+
+	tSpan.m_iNumValues = iEnd-iStart;
+	m_tRowID = tSubblockStart + iEnd;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+template<typename T, typename RD>
+class GroupCounter_INT_T : public GroupCounter_i, public Accessor_INT_T<T,RD>
+{
+	using BASE = Accessor_INT_T<T,RD>;
+	using BASE::Accessor_INT_T;
+
+public:
+	void		Count ( uint32_t tMinRowID, uint32_t tMaxRowID ) final;
+	void		GetGroups ( std::vector<GroupCount_t> & dGroups ) const final;
+
+private:
+	std::unordered_map<int64_t,int64_t>	m_hCounts;
+
+	void		CountBlock ( uint32_t uStartInBlock, uint32_t uEndInBlock );
+	void		CountValues ( const Span_T<const T> & dValues, int iStart, int iEnd );
+};
+
+template<typename T, typename RD>
+void GroupCounter_INT_T<T,RD>::Count ( uint32_t tMinRowID, uint32_t tMaxRowID )
+{
+	ForEachBlock ( tMinRowID, std::min ( tMaxRowID, BASE::m_tHeader.GetNumDocs() ), [this]( uint32_t uBlockId, uint32_t uStartInBlock, uint32_t uEndInBlock )
+		{
+			if ( uBlockId!=BASE::m_uBlockId )
+				BASE::SetCurBlock(uBlockId);
+
+			CountBlock ( uStartInBlock, uEndInBlock );
+		} );
+}
+
+template<typename T, typename RD>
+void GroupCounter_INT_T<T,RD>::CountBlock ( uint32_t uStartInBlock, uint32_t uEndInBlock )
+{
+	auto & tReader = *BASE::m_pReader;
+	auto & tBlockPFOR = BASE::m_tBlockPFOR;
+
+	switch ( BASE::m_ePacking )
+	{
+	case IntPacking_e::CONST:
+		m_hCounts[(int64_t)BASE::m_tBlockConst.GetValue()] += uEndInBlock-uStartInBlock;
+		break;
+
+	case IntPacking_e::TABLE:
+	{
+		// count codes over the whole range first; table values are looked up once per block
+		CodeCounts_t dCounts {};
+		BASE::ForEachSubblock ( uStartInBlock, uEndInBlock, [this, &dCounts, &tReader]( int iSubblockId, int iNumValues, int iStart, int iEnd )
+			{
+				BASE::m_tBlockTable.ReadSubblock ( iSubblockId, iNumValues, tReader );
+				const uint32_t * pIndexes = BASE::m_tBlockTable.GetValueIndexes().data();
+				CountCodes ( pIndexes+iStart, pIndexes+iEnd, dCounts );
+			} );
+
+		for ( int i = 0; i < BASE::m_tBlockTable.GetTableSize(); i++ )
+			if ( dCounts[i] )
+				m_hCounts[(int64_t)BASE::m_tBlockTable.GetValueFromTable ( (uint8_t)i )] += dCounts[i];
+	}
+	break;
+
+	case IntPacking_e::DELTA:
+		BASE::ForEachSubblock ( uStartInBlock, uEndInBlock, [this, &tBlockPFOR, &tReader]( int iSubblockId, int iNumValues, int iStart, int iEnd )
+			{
+				tBlockPFOR.ReadSubblock_Delta ( iSubblockId, iNumValues, tReader );
+				CountValues ( tBlockPFOR.GetAllValues(), iStart, iEnd );
+			} );
+		break;
+
+	case IntPacking_e::GENERIC:
+		BASE::ForEachSubblock ( uStartInBlock, uEndInBlock, [this, &tBlockPFOR, &tReader]( int iSubblockId, int iNumValues, int iStart, int iEnd )
+			{
+				tBlockPFOR.ReadSubblock_Generic ( iSubblockId, iNumValues, tReader );
+				CountValues ( tBlockPFOR.GetAllValues(), iStart, iEnd );
+			} );
+		break;
+
+	case IntPacking_e::HASH:
+		BASE::ForEachSubblock ( uStartInBlock, uEndInBlock, [this, &tBlockPFOR, &tReader]( int iSubblockId, int iNumValues, int iStart, int iEnd )
+			{
+				tBlockPFOR.ReadSubblock_Hash ( iSubblockId, iNumValues, tReader );
+				CountValues ( tBlockPFOR.GetAllValues(), iStart, iEnd );
+			} );
+		break;
+
+	case IntPacking_e::FLOAT:
+		BASE::ForEachSubblock ( uStartInBlock, uEndInBlock, [this, &tBlockPFOR, &tReader]( int iSubblockId, int iNumValues, int iStart, int iEnd )
+			{
+				tBlockPFOR.ReadSubblock_Float ( iSubblockId, iNumValues, tReader );
+				CountValues ( tBlockPFOR.GetAllValues(), iStart, iEnd );
+			} );
+		break;
+
+	case IntPacking_e::RLE:
+		BASE::m_tBlockRLE.GetRuns().ForEachRun ( uStartInBlock, uEndInBlock, [this]( int iRun, uint32_t uStart, uint32_t uEnd )
+			{ m_hCounts[(int64_t)BASE::m_tBlockRLE.GetRunValue(iRun)] += uEnd-uStart; } );
+		break;
+
+	default:
+		assert ( 0 && "Packing not implemented yet" );
+		break;
+	}
+}
+
+template<typename T, typename RD>
+void GroupCounter_INT_T<T,RD>::CountValues ( const Span_T<const T> & dValues, int iStart, int iEnd )
+{
+	for ( int i = iStart; i < iEnd; i++ )
+		m_hCounts[(int64_t)dValues[i]]++;
+}
+
+template<typename T, typename RD>
+void GroupCounter_INT_T<T,RD>::GetGroups ( std::vector<GroupCount_t> & dGroups ) const
+{
+	dGroups.resize(0);
+	dGroups.reserve ( m_hCounts.size() );
+	for ( const auto & i : m_hCounts )
+	{
+		GroupCount_t tGroup;
+		tGroup.m_iValue = i.first;
+		tGroup.m_iCount = i.second;
+		dGroups.push_back(tGroup);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 class AnalyzerBlock_c : public Filter_t
 {
 public:
@@ -466,6 +972,9 @@ public:
 protected:
 	uint32_t &	m_tRowID;
 	int64_t		m_tValue;
+
+	template<typename RANGE_EVAL>
+	FORCE_INLINE bool	ValueMatches ( int64_t tValue, bool bEq ) const;
 };
 
 
@@ -482,24 +991,9 @@ void AnalyzerBlock_c::Setup ( const Filter_t & tSettings )
 		m_tValue = m_dValues[0];
 }
 
-//////////////////////////////////////////////////////////////////////////
-
-class AnalyzerBlock_Int_Const_c : public AnalyzerBlock_c
-{
-	using AnalyzerBlock_c::AnalyzerBlock_c;
-
-public:
-	template<typename T, typename RANGE_EVAL>
-	FORCE_INLINE bool	SetupNextBlock ( const StoredBlock_Int_Const_T<T> & tBlock, bool bEq );
-	FORCE_INLINE int	ProcessSubblock ( uint32_t * & pRowID, int iNumValues ) { return FillWithIncreasingValues ( pRowID, iNumValues, m_tRowID ); }
-};
-
-
-template<typename T, typename RANGE_EVAL>
-bool AnalyzerBlock_Int_Const_c::SetupNextBlock ( const StoredBlock_Int_Const_T<T> & tBlock, bool bEq )
+template<typename RANGE_EVAL>
+bool AnalyzerBlock_c::ValueMatches ( int64_t tValue, bool bEq ) const
 {
-	int64_t tValue = tBlock.GetValue();
-
 	switch ( m_eType )
 	{
 	case FilterType_e::VALUES:
@@ -537,6 +1031,74 @@ bool AnalyzerBlock_Int_Const_c::SetupNextBlock ( const StoredBlock_Int_Const_T<T
 
 //////////////////////////////////////////////////////////////////////////
 
+class AnalyzerBlock_Int_Const_c : public AnalyzerBlock_c
+{
+	using AnalyzerBlock_c::AnalyzerBlock_c;
+
+public:
+	template<typename T, typename RANGE_EVAL>
+	FORCE_INLINE bool	SetupNextBlock ( const StoredBlock_Int_Const_T<T> & tBlock, bool bEq );
+	FORCE_INLINE int	ProcessSubblock ( uint32_t * & pRowID, int iNumValues ) { return FillWithIncreasingValues ( pRowID, iNumValues, m_tRowID ); }
+};
+
+
+template<typename T, typename RANGE_EVAL>
+bool AnalyzerBlock_Int_Const_c::SetupNextBlock ( const StoredBlock_Int_Const_T<T> & tBlock, bool bEq )
+{
+	return ValueMatches<RANGE_EVAL> ( (int64_t)tBlock.GetValue(), bEq );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+class AnalyzerBlock_Int_RLE_c : public AnalyzerBlock_c
+{
+	using AnalyzerBlock_c::AnalyzerBlock_c;
+
+public:
+	template<typename T, typename RANGE_EVAL>
+	FORCE_INLINE bool	SetupNextBlock ( StoredBlock_Int_RLE_T<T> & tBlock, bool bEq, bool & bAllMatch );
+	FORCE_INLINE int	ProcessSubblock ( uint32_t * & pRowID, uint32_t uStartInBlock, int iNumValues );
+
+private:
+	BlockRuns_c *			m_pRuns = nullptr;
+	std::vector<uint8_t>	m_dRunMatches;
+};
+
+template<typename T, typename RANGE_EVAL>
+bool AnalyzerBlock_Int_RLE_c::SetupNextBlock ( StoredBlock_Int_RLE_T<T> & tBlock, bool bEq, bool & bAllMatch )
+{
+	// the filter is evaluated once per run, not once per value
+	m_pRuns = &tBlock.GetRuns();
+	int iNumRuns = m_pRuns->GetNumRuns();
+	m_dRunMatches.resize(iNumRuns);
+
+	int iMatching = 0;
+	for ( int i = 0; i < iNumRuns; i++ )
+	{
+		m_dRunMatches[i] = ValueMatches<RANGE_EVAL> ( (int64_t)tBlock.GetRunValue(i), bEq ) ? 1 : 0;
+		iMatching += m_dRunMatches[i];
+	}
+
+	bAllMatch = iMatching==iNumRuns;
+	return iMatching>0;
+}
+
+
+int AnalyzerBlock_Int_RLE_c::ProcessSubblock ( uint32_t * & pRowID, uint32_t uStartInBlock, int iNumValues )
+{
+	m_pRuns->ForEachRun ( uStartInBlock, uStartInBlock+iNumValues, [this, &pRowID]( int iRun, uint32_t uRunStart, uint32_t uRunEnd )
+		{
+			if ( m_dRunMatches[iRun] )
+				FillWithIncreasingValues ( pRowID, uRunEnd-uRunStart, m_tRowID );
+			else
+				m_tRowID += uRunEnd-uRunStart;
+		} );
+
+	return iNumValues;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 class AnalyzerBlock_Int_Table_c : public AnalyzerBlock_c
 {
 	using AnalyzerBlock_c::AnalyzerBlock_c;
@@ -763,17 +1325,17 @@ class AnalyzerBlock_Int_Values_T : public AnalyzerBlock_c
 	using AnalyzerBlock_c::AnalyzerBlock_c;
 
 public:
-	template <bool EQ> FORCE_INLINE int	ProcessSubblock_SingleValue ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
-	template <bool EQ> FORCE_INLINE int	ProcessSubblock_ValuesLinear ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
-	template <bool EQ> FORCE_INLINE int	ProcessSubblock_ValuesBinary ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
+	template <bool EQ> FORCE_INLINE int	ProcessSubblock_SingleValue ( uint32_t * & pRowID, const Span_T<const ACCESSOR_VALUES> & dValues );
+	template <bool EQ> FORCE_INLINE int	ProcessSubblock_ValuesLinear ( uint32_t * & pRowID, const Span_T<const ACCESSOR_VALUES> & dValues );
+	template <bool EQ> FORCE_INLINE int	ProcessSubblock_ValuesBinary ( uint32_t * & pRowID, const Span_T<const ACCESSOR_VALUES> & dValues );
 
-	template<typename RANGE_EVAL> FORCE_INLINE int	ProcessSubblock_Range ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
-	template<typename RANGE_EVAL> FORCE_INLINE int	ProcessSubblock_FloatRange ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
+	template<typename RANGE_EVAL> FORCE_INLINE int	ProcessSubblock_Range ( uint32_t * & pRowID, const Span_T<const ACCESSOR_VALUES> & dValues );
+	template<typename RANGE_EVAL> FORCE_INLINE int	ProcessSubblock_FloatRange ( uint32_t * & pRowID, const Span_T<const ACCESSOR_VALUES> & dValues );
 };
 
 template<typename VALUES, typename ACCESSOR_VALUES>
 template <bool EQ>
-int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_SingleValue ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues )
+int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_SingleValue ( uint32_t * & pRowID, const Span_T<const ACCESSOR_VALUES> & dValues )
 {
 	uint32_t tRowID = m_tRowID;
 
@@ -791,7 +1353,7 @@ int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_SingleVa
 
 template<typename VALUES, typename ACCESSOR_VALUES>
 template <bool EQ>
-int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_ValuesLinear ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues )
+int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_ValuesLinear ( uint32_t * & pRowID, const Span_T<const ACCESSOR_VALUES> & dValues )
 {
 	uint32_t tRowID = m_tRowID;
 
@@ -813,7 +1375,7 @@ int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_ValuesLi
 
 template<typename VALUES, typename ACCESSOR_VALUES>
 template <bool EQ>
-int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_ValuesBinary ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues )
+int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_ValuesBinary ( uint32_t * & pRowID, const Span_T<const ACCESSOR_VALUES> & dValues )
 {
 	uint32_t tRowID = m_tRowID;
 
@@ -831,13 +1393,15 @@ int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_ValuesBi
 
 template<typename VALUES, typename ACCESSOR_VALUES>
 template<typename RANGE_EVAL>
-int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_Range ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues )
+int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_Range ( uint32_t * & pRowID, const Span_T<const ACCESSOR_VALUES> & dValues )
 {
 	uint32_t tRowID = m_tRowID;
+	size_t tProcessed = FilterRange_SIMD<RANGE_EVAL> ( dValues.data(), dValues.size(), (VALUES)m_iMinValue, (VALUES)m_iMaxValue, tRowID, pRowID );
+	tRowID += (uint32_t)tProcessed;
 
-	for ( auto i : dValues )
+	for ( size_t i = tProcessed; i < dValues.size(); i++ )
 	{
-		if ( RANGE_EVAL::Eval ( (VALUES)i, (VALUES)m_iMinValue, (VALUES)m_iMaxValue ) )
+		if ( RANGE_EVAL::Eval ( (VALUES)dValues[i], (VALUES)m_iMinValue, (VALUES)m_iMaxValue ) )
 			*pRowID++ = tRowID;
 
 		tRowID++;
@@ -849,13 +1413,15 @@ int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_Range (
 
 template<>
 template<typename RANGE_EVAL>
-int AnalyzerBlock_Int_Values_T<float,uint32_t>::ProcessSubblock_Range ( uint32_t * & pRowID, const Span_T<uint32_t> & dValues )
+int AnalyzerBlock_Int_Values_T<float,uint32_t>::ProcessSubblock_Range ( uint32_t * & pRowID, const Span_T<const uint32_t> & dValues )
 {
 	uint32_t tRowID = m_tRowID;
+	size_t tProcessed = FilterRange_SIMD<RANGE_EVAL> ( dValues.data(), dValues.size(), m_fMinValue, m_fMaxValue, tRowID, pRowID );
+	tRowID += (uint32_t)tProcessed;
 
-	for ( auto i : dValues )
+	for ( size_t i = tProcessed; i < dValues.size(); i++ )
 	{
-		if ( RANGE_EVAL::Eval ( UintToFloat(i), m_fMinValue, m_fMaxValue ) )
+		if ( RANGE_EVAL::Eval ( UintToFloat ( dValues[i] ), m_fMinValue, m_fMaxValue ) )
 			*pRowID++ = tRowID;
 
 		tRowID++;
@@ -876,7 +1442,7 @@ class Analyzer_INT_T : public Analyzer_T<HAVE_MATCHING_BLOCKS>, public Accessor_
 	using ACCESSOR = Accessor_INT_T<ACCESSOR_VALUES,RD>;
 
 public:
-					Analyzer_INT_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader, const Filter_t & tSettings );
+					Analyzer_INT_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, RD * pReader, const Filter_t & tSettings );
 
 	bool			GetNextRowIdBlock ( Span_T<uint32_t> & dRowIdBlock ) final;
 	void			AddDesc ( std::vector<IteratorDesc_t> & dDesc ) const final { dDesc.push_back ( { ACCESSOR::m_tHeader.GetName(), "ColumnarScan" } ); }
@@ -884,6 +1450,7 @@ public:
 private:
 	AnalyzerBlock_Int_Const_c	m_tBlockConst;
 	AnalyzerBlock_Int_Table_c	m_tBlockTable;
+	AnalyzerBlock_Int_RLE_c		m_tBlockRLE;
 	AnalyzerBlock_Int_Values_T<VALUES, ACCESSOR_VALUES> m_tBlockValues;
 
 	Filter_t 			m_tSettings;
@@ -900,11 +1467,16 @@ private:
 	void				SetupPackingFuncs();
 
 	int					ProcessSubblockConst ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int					ProcessSubblockRLE ( uint32_t * & pRowID, int iSubblockIdInBlock );
 
 	template <bool EQ>	int	ProcessSubblockGeneric_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	template <bool EQ, bool LINEAR>	int	ProcessSubblockGeneric_Values ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	int					ProcessSubblockGeneric_Range ( uint32_t * & pRowID, int iSubblockIdInBlock );
 
+	template <bool EQ>	int	ProcessSubblockFloat_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	template <bool EQ, bool LINEAR>	int	ProcessSubblockFloat_Values ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int					ProcessSubblockFloat_Range ( uint32_t * & pRowID, int iSubblockIdInBlock );
+
 	template <bool EQ>	int	ProcessSubblockHash_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	template <bool EQ, bool LINEAR>	int	ProcessSubblockHash_Values ( uint32_t * & pRowID, int iSubblockIdInBlock );
 
@@ -920,11 +1492,12 @@ private:
 };
 
 template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL, bool HAVE_MATCHING_BLOCKS, typename RD>
-Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::Analyzer_INT_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader, const Filter_t & tSettings )
+Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::Analyzer_INT_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, RD * pReader, const Filter_t & tSettings )
 	: ANALYZER ( tHeader.GetSettings().m_iSubblockSize )
-	, ACCESSOR ( tHeader, uVersion, pReader )
+	, ACCESSOR ( tHeader, uVersion, pCache, pReader )
 	, m_tBlockConst ( ANALYZER::m_tRowID )
 	, m_tBlockTable ( ANALYZER::m_tRowID )
+	, m_tBlockRLE ( ANALYZER::m_tRowID )
 	, m_tBlockValues ( ANALYZER::m_tRowID )
 	, m_tSettings ( tSettings )
 {
@@ -932,6 +1505,7 @@ Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::Analy
 
 	m_tBlockConst.Setup(m_tSettings);
 	m_tBlockTable.Setup(m_tSettings);
+	m_tBlockRLE.Setup(m_tSettings);
 	m_tBlockValues.Setup(m_tSettings);
 
 	SetupPackingFuncs();
@@ -947,6 +1521,7 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockDelta_SingleValue<false>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC )]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockGeneric_SingleValue<false>;
 		dFuncs [ to_underlying ( IntPacking_e::HASH )]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockHash_SingleValue<false>;
+		dFuncs [ to_underlying ( IntPacking_e::FLOAT )]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockFloat_SingleValue<false>;
 	}
 	else
 	{
@@ -954,6 +1529,7 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockDelta_SingleValue<true>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC )]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockGeneric_SingleValue<true>;
 		dFuncs [ to_underlying ( IntPacking_e::HASH )]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockHash_SingleValue<true>;
+		dFuncs [ to_underlying ( IntPacking_e::FLOAT )]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockFloat_SingleValue<true>;
 	}
 }
 
@@ -967,6 +1543,7 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockDelta_Values<false,true>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockGeneric_Values<false,true>;
 		dFuncs [ to_underlying ( IntPacking_e::HASH )]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockHash_Values<false,true>;
+		dFuncs [ to_underlying ( IntPacking_e::FLOAT )]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockFloat_Values<false,true>;
 	}
 	else
 	{
@@ -974,6 +1551,7 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockDelta_Values<true,true>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockGeneric_Values<true,true>;
 		dFuncs [ to_underlying ( IntPacking_e::HASH )]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockHash_Values<true,true>;
+		dFuncs [ to_underlying ( IntPacking_e::FLOAT )]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockFloat_Values<true,true>;
 	}
 }
 
@@ -987,6 +1565,7 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockDelta_Values<false,false>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockGeneric_Values<false,false>;
 		dFuncs [ to_underlying ( IntPacking_e::HASH ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockHash_Values<false,false>;
+		dFuncs [ to_underlying ( IntPacking_e::FLOAT ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockFloat_Values<false,false>;
 	}
 	else
 	{
@@ -994,6 +1573,7 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockDelta_Values<true,false>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockGeneric_Values<true,false>;
 		dFuncs [ to_underlying ( IntPacking_e::HASH ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockHash_Values<true,false>;
+		dFuncs [ to_underlying ( IntPacking_e::FLOAT ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockFloat_Values<true,false>;
 	}
 }
 
@@ -1004,6 +1584,7 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::
 	dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockTable_Range;
 	dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockDelta_Range;
 	dFuncs [ to_underlying ( IntPacking_e::GENERIC ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockGeneric_Range;
+	dFuncs [ to_underlying ( IntPacking_e::FLOAT ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockFloat_Range;
 	// no range analyzer for HASH packing
 }
 
@@ -1019,6 +1600,9 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::
 	// doesn't depend on filter type; just fills result with rowids
 	dFuncs [ to_underlying ( IntPacking_e::CONST ) ] = &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockConst;
 
+	// runs are matched against the filter when the block is loaded
+	dFuncs [ to_underlying ( IntPacking_e::RLE ) ] = &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockRLE;
+
 	switch ( m_tSettings.m_eType )
 	{
 	case FilterType_e::VALUES:
@@ -1047,6 +1631,12 @@ int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::P
 	return m_tBlockConst.ProcessSubblock ( pRowID, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock) );
 }
 
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL, bool HAVE_MATCHING_BLOCKS, typename RD>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockRLE ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	return m_tBlockRLE.ProcessSubblock ( pRowID, StoredBlockTraits_t::SubblockId2RowId(iSubblockIdInBlock), StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock) );
+}
+
 template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL, bool HAVE_MATCHING_BLOCKS, typename RD>
 template <bool EQ>
 int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockGeneric_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock )
@@ -1074,6 +1664,33 @@ int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::P
 	return m_tBlockValues.template ProcessSubblock_Range<RANGE_EVAL> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
 }
 
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL, bool HAVE_MATCHING_BLOCKS, typename RD>
+template <bool EQ>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockFloat_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ACCESSOR::m_tBlockPFOR.ReadSubblock_Float ( iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
+	return m_tBlockValues.template ProcessSubblock_SingleValue<EQ> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL, bool HAVE_MATCHING_BLOCKS, typename RD>
+template <bool EQ, bool LINEAR>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockFloat_Values ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ACCESSOR::m_tBlockPFOR.ReadSubblock_Float ( iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
+
+	if ( LINEAR )
+		return m_tBlockValues.template ProcessSubblock_ValuesLinear<EQ> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
+
+	return m_tBlockValues.template ProcessSubblock_ValuesBinary<EQ> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL, bool HAVE_MATCHING_BLOCKS, typename RD>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockFloat_Range ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ACCESSOR::m_tBlockPFOR.ReadSubblock_Float ( iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
+	return m_tBlockValues.template ProcessSubblock_Range<RANGE_EVAL> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
+}
+
 template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL, bool HAVE_MATCHING_BLOCKS, typename RD>
 template <bool EQ>
 int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::ProcessSubblockHash_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock )
@@ -1162,6 +1779,7 @@ bool Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::
 
 	while(true)
 	{
+		ANALYZER::PrefetchBlocks ( (ACCESSOR&)*this, iNextBlock );
 		ANALYZER::m_iCurBlockId = iNextBlock;
 		ACCESSOR::SetCurBlock ( ANALYZER::m_iCurBlockId );
 
@@ -1180,6 +1798,15 @@ bool Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::
 				ePackingForProcessingFunc = IntPacking_e::CONST;
 			break;
 
+		case IntPacking_e::RLE:
+		{
+			bool bAllMatch = false;
+			bProcessBlock = m_tBlockRLE.SetupNextBlock<ACCESSOR_VALUES,RANGE_EVAL> ( ACCESSOR::m_tBlockRLE, !m_tSettings.m_bExclude, bAllMatch );
+			if ( bProcessBlock && bAllMatch )
+				ePackingForProcessingFunc = IntPacking_e::CONST;
+		}
+		break;
+
 		default:
 			break;
 		}
@@ -1200,6 +1827,11 @@ bool Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL,HAVE_MATCHING_BLOCKS,RD>::
 template < bool LEFT_CLOSED, bool RIGHT_CLOSED, bool LEFT_UNBOUNDED, bool RIGHT_UNBOUNDED >
 struct ValueInInterval_T
 {
+	static const bool CLOSED_LEFT = LEFT_CLOSED;
+	static const bool CLOSED_RIGHT = RIGHT_CLOSED;
+	static const bool UNBOUNDED_LEFT = LEFT_UNBOUNDED;
+	static const bool UNBOUNDED_RIGHT = RIGHT_UNBOUNDED;
+
 	template<typename T=int64_t>
 	static FORCE_INLINE bool Eval ( T tValue, T tMin, T tMax )
 	{
@@ -1209,31 +1841,41 @@ struct ValueInInterval_T
 
 //////////////////////////////////////////////////////////////////////////
 
-Iterator_i * CreateIteratorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, FileReader_c * pReader )		{ return ::new Iterator_INT_T<uint32_t,FileReader_c> ( tHeader, uVersion, pReader ); }
-Iterator_i * CreateIteratorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, MappedReader_c * pReader )		{ return ::new Iterator_INT_T<uint32_t,MappedReader_c> ( tHeader, uVersion, pReader ); }
+Iterator_i * CreateIteratorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, FileReader_c * pReader )		{ return ::new Iterator_INT_T<uint32_t,FileReader_c> ( tHeader, uVersion, pCache, pReader ); }
+Iterator_i * CreateIteratorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, MappedReader_c * pReader )		{ return ::new Iterator_INT_T<uint32_t,MappedReader_c> ( tHeader, uVersion, pCache, pReader ); }
+
+Iterator_i * CreateIteratorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, FileReader_c * pReader )		{ return ::new Iterator_INT_T<uint64_t,FileReader_c> ( tHeader, uVersion, pCache, pReader ); }
+Iterator_i * CreateIteratorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, MappedReader_c * pReader )		{ return ::new Iterator_INT_T<uint64_t,MappedReader_c> ( tHeader, uVersion, pCache, pReader ); }
+
+ScanCursor_i * CreateScanCursorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, FileReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID )		{ return ::new ScanCursor_INT_T<uint32_t,FileReader_c> ( tHeader, uVersion, pCache, pReader, tMinRowID, tMaxRowID ); }
+ScanCursor_i * CreateScanCursorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, MappedReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID )	{ return ::new ScanCursor_INT_T<uint32_t,MappedReader_c> ( tHeader, uVersion, pCache, pReader, tMinRowID, tMaxRowID ); }
+ScanCursor_i * CreateScanCursorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, FileReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID )		{ return ::new ScanCursor_INT_T<uint64_t,FileReader_c> ( tHeader, uVersion, pCache, pReader, tMinRowID, tMaxRowID ); }
+ScanCursor_i * CreateScanCursorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, MappedReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID )	{ return ::new ScanCursor_INT_T<uint64_t,MappedReader_c> ( tHeader, uVersion, pCache, pReader, tMinRowID, tMaxRowID ); }
 
-Iterator_i * CreateIteratorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, FileReader_c * pReader )		{ return ::new Iterator_INT_T<uint64_t,FileReader_c> ( tHeader, uVersion, pReader ); }
-Iterator_i * CreateIteratorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, MappedReader_c * pReader )		{ return ::new Iterator_INT_T<uint64_t,MappedReader_c> ( tHeader, uVersion, pReader ); }
+GroupCounter_i * CreateGroupCounterUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, FileReader_c * pReader )		{ return ::new GroupCounter_INT_T<uint32_t,FileReader_c> ( tHeader, uVersion, pCache, pReader ); }
+GroupCounter_i * CreateGroupCounterUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, MappedReader_c * pReader )	{ return ::new GroupCounter_INT_T<uint32_t,MappedReader_c> ( tHeader, uVersion, pCache, pReader ); }
+GroupCounter_i * CreateGroupCounterUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, FileReader_c * pReader )		{ return ::new GroupCounter_INT_T<uint64_t,FileReader_c> ( tHeader, uVersion, pCache, pReader ); }
+GroupCounter_i * CreateGroupCounterUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, MappedReader_c * pReader )	{ return ::new GroupCounter_INT_T<uint64_t,MappedReader_c> ( tHeader, uVersion, pCache, pReader ); }
 
 //////////////////////////////////////////////////////////////////////////
 
 template <typename RANGE_EVAL, bool MATCHING_BLOCKS, typename RD>
-static Analyzer_i * CreateAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader, const Filter_t & tSettings )
+static Analyzer_i * CreateAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, RD * pReader, const Filter_t & tSettings )
 {
 	switch ( tHeader.GetType() )
 	{
 	case AttrType_e::UINT32:
 	case AttrType_e::TIMESTAMP:
-		return ::new Analyzer_INT_T<uint32_t, uint32_t, RANGE_EVAL, MATCHING_BLOCKS, RD> ( tHeader, uVersion, pReader, tSettings );
+		return ::new Analyzer_INT_T<uint32_t, uint32_t, RANGE_EVAL, MATCHING_BLOCKS, RD> ( tHeader, uVersion, pCache, pReader, tSettings );
 
 	case AttrType_e::INT64:
-		return ::new Analyzer_INT_T<int64_t, uint64_t, RANGE_EVAL, MATCHING_BLOCKS, RD> ( tHeader, uVersion, pReader, tSettings );
+		return ::new Analyzer_INT_T<int64_t, uint64_t, RANGE_EVAL, MATCHING_BLOCKS, RD> ( tHeader, uVersion, pCache, pReader, tSettings );
 
 	case AttrType_e::UINT64:
-		return ::new Analyzer_INT_T<uint64_t, uint64_t, RANGE_EVAL, MATCHING_BLOCKS, RD> ( tHeader, uVersion, pReader, tSettings );
+		return ::new Analyzer_INT_T<uint64_t, uint64_t, RANGE_EVAL, MATCHING_BLOCKS, RD> ( tHeader, uVersion, pCache, pReader, tSettings );
 
 	case AttrType_e::FLOAT:
-		return ::new Analyzer_INT_T<float, uint32_t, RANGE_EVAL, MATCHING_BLOCKS, RD> ( tHeader, uVersion, pReader, tSettings );
+		return ::new Analyzer_INT_T<float, uint32_t, RANGE_EVAL, MATCHING_BLOCKS, RD> ( tHeader, uVersion, pCache, pReader, tSettings );
 
 	default:
 		assert ( 0 && "Unknown int analyzer" );
@@ -1243,7 +1885,7 @@ static Analyzer_i * CreateAnalyzerInt ( const AttributeHeader_i & tHeader, uint3
 
 
 template <typename RD>
-static Analyzer_i * NewAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader, const Filter_t & tSettings, bool bHaveMatchingBlocks )
+static Analyzer_i * NewAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, RD * pReader, const Filter_t & tSettings, bool bHaveMatchingBlocks )
 {
 	if ( tSettings.m_eType!=FilterType_e::VALUES && tSettings.m_eType!=FilterType_e::RANGE && tSettings.m_eType!=FilterType_e::FLOATRANGE )
 		return nullptr;
@@ -1254,45 +1896,45 @@ static Analyzer_i * NewAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t
 	int iIndex = bHaveMatchingBlocks*16 + tSettings.m_bLeftClosed*8 + tSettings.m_bRightClosed*4 + tSettings.m_bLeftUnbounded*2 + tSettings.m_bRightUnbounded;
  	switch ( iIndex )
 	{
-	case 0:		return CreateAnalyzerInt<ValueInInterval_T<false, false, false, false>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 1:		return CreateAnalyzerInt<ValueInInterval_T<false, false, false, true>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 2:		return CreateAnalyzerInt<ValueInInterval_T<false, false, true,  false>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 3:		return CreateAnalyzerInt<ValueInInterval_T<false, false, true,  true>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 4:		return CreateAnalyzerInt<ValueInInterval_T<false, true,  false, false>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 5:		return CreateAnalyzerInt<ValueInInterval_T<false, true,  false, true>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 6:		return CreateAnalyzerInt<ValueInInterval_T<false, true,  true,  false>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 7:		return CreateAnalyzerInt<ValueInInterval_T<false, true,  true,  true>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 8:		return CreateAnalyzerInt<ValueInInterval_T<true,  false, false, false>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 9:		return CreateAnalyzerInt<ValueInInterval_T<true,  false, false, true>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 10:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, true,  false>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 11:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, true,  true>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 12:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  false, false>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 13:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  false, true>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 14:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  true,  false>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 15:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  true,  true>,	false>	( tHeader, uVersion, pReader, tSettings );
-	case 16:	return CreateAnalyzerInt<ValueInInterval_T<false, false, false, false>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 17:	return CreateAnalyzerInt<ValueInInterval_T<false, false, false, true>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 18:	return CreateAnalyzerInt<ValueInInterval_T<false, false, true,  false>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 19:	return CreateAnalyzerInt<ValueInInterval_T<false, false, true,  true>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 20:	return CreateAnalyzerInt<ValueInInterval_T<false, true,  false, false>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 21:	return CreateAnalyzerInt<ValueInInterval_T<false, true,  false, true>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 22:	return CreateAnalyzerInt<ValueInInterval_T<false, true,  true,  false>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 23:	return CreateAnalyzerInt<ValueInInterval_T<false, true,  true,  true>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 24:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, false, false>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 25:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, false, true>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 26:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, true,  false>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 27:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, true,  true>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 28:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  false, false>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 29:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  false, true>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 30:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  true,  false>,	true>	( tHeader, uVersion, pReader, tSettings );
-	case 31:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  true,  true>,	true>	( tHeader, uVersion, pReader, tSettings );
+	case 0:		return CreateAnalyzerInt<ValueInInterval_T<false, false, false, false>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 1:		return CreateAnalyzerInt<ValueInInterval_T<false, false, false, true>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 2:		return CreateAnalyzerInt<ValueInInterval_T<false, false, true,  false>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 3:		return CreateAnalyzerInt<ValueInInterval_T<false, false, true,  true>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 4:		return CreateAnalyzerInt<ValueInInterval_T<false, true,  false, false>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 5:		return CreateAnalyzerInt<ValueInInterval_T<false, true,  false, true>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 6:		return CreateAnalyzerInt<ValueInInterval_T<false, true,  true,  false>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 7:		return CreateAnalyzerInt<ValueInInterval_T<false, true,  true,  true>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 8:		return CreateAnalyzerInt<ValueInInterval_T<true,  false, false, false>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 9:		return CreateAnalyzerInt<ValueInInterval_T<true,  false, false, true>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 10:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, true,  false>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 11:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, true,  true>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 12:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  false, false>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 13:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  false, true>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 14:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  true,  false>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 15:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  true,  true>,	false>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 16:	return CreateAnalyzerInt<ValueInInterval_T<false, false, false, false>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 17:	return CreateAnalyzerInt<ValueInInterval_T<false, false, false, true>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 18:	return CreateAnalyzerInt<ValueInInterval_T<false, false, true,  false>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 19:	return CreateAnalyzerInt<ValueInInterval_T<false, false, true,  true>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 20:	return CreateAnalyzerInt<ValueInInterval_T<false, true,  false, false>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 21:	return CreateAnalyzerInt<ValueInInterval_T<false, true,  false, true>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 22:	return CreateAnalyzerInt<ValueInInterval_T<false, true,  true,  false>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 23:	return CreateAnalyzerInt<ValueInInterval_T<false, true,  true,  true>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 24:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, false, false>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 25:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, false, true>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 26:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, true,  false>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 27:	return CreateAnalyzerInt<ValueInInterval_T<true,  false, true,  true>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 28:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  false, false>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 29:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  false, true>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 30:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  true,  false>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
+	case 31:	return CreateAnalyzerInt<ValueInInterval_T<true,  true,  true,  true>,	true>	( tHeader, uVersion, pCache, pReader, tSettings );
 	default:	return nullptr;
 	}
 }
 
 
-Analyzer_i * CreateAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, FileReader_c * pReader, const Filter_t & tSettings, bool bHaveMatchingBlocks )		{ return NewAnalyzerInt ( tHeader, uVersion, pReader, tSettings, bHaveMatchingBlocks ); }
-Analyzer_i * CreateAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, MappedReader_c * pReader, const Filter_t & tSettings, bool bHaveMatchingBlocks )	{ return NewAnalyzerInt ( tHeader, uVersion, pReader, tSettings, bHaveMatchingBlocks ); }
+Analyzer_i * CreateAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, FileReader_c * pReader, const Filter_t & tSettings, bool bHaveMatchingBlocks )		{ return NewAnalyzerInt ( tHeader, uVersion, pCache, pReader, tSettings, bHaveMatchingBlocks ); }
+Analyzer_i * CreateAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, MappedReader_c * pReader, const Filter_t & tSettings, bool bHaveMatchingBlocks )	{ return NewAnalyzerInt ( tHeader, uVersion, pCache, pReader, tSettings, bHaveMatchingBlocks ); }
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -1309,7 +1951,7 @@ private:
 bool Checker_Int_c::CheckBlockHeader ( uint32_t uBlockId )
 {
 	uint32_t uPacking = m_pReader->Unpack_uint32();
-	if ( uPacking!=(uint32_t)IntPacking_e::CONST && uPacking!=(uint32_t)IntPacking_e::TABLE && uPacking!=(uint32_t)IntPacking_e::DELTA && uPacking!=(uint32_t)IntPacking_e::GENERIC && uPacking!=(uint32_t)IntPacking_e::HASH )
+	if ( uPacking!=(uint32_t)IntPacking_e::CONST && uPacking!=(uint32_t)IntPacking_e::TABLE && uPacking!=(uint32_t)IntPacking_e::DELTA && uPacking!=(uint32_t)IntPacking_e::GENERIC && uPacking!=(uint32_t)IntPacking_e::HASH && uPacking!=(uint32_t)IntPacking_e::FLOAT && uPacking!=(uint32_t)IntPacking_e::RLE )
 	{
 		m_fnError ( FormatStr ( "Unknown encoding of block %u: %u", uBlockId, uPacking ).c_str() );
 		return false;
@@ -33,17 +33,30 @@ namespace columnar
 {
 
 class Iterator_i;
+class ScanCursor_i;
+class GroupCounter_i;
 class Analyzer_i;
 class Checker_i;
 class AttributeHeader_i;
+class SubblockCache_c;
 
-Iterator_i *	CreateIteratorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::FileReader_c * pReader );
-Iterator_i *	CreateIteratorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::MappedReader_c * pReader );
-Iterator_i *	CreateIteratorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::FileReader_c * pReader );
-Iterator_i *	CreateIteratorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::MappedReader_c * pReader );
+Iterator_i *	CreateIteratorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::FileReader_c * pReader );
+Iterator_i *	CreateIteratorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::MappedReader_c * pReader );
+Iterator_i *	CreateIteratorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::FileReader_c * pReader );
+Iterator_i *	CreateIteratorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::MappedReader_c * pReader );
 
-Analyzer_i *	CreateAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::FileReader_c * pReader, const common::Filter_t & tSettings, bool bHaveMatchingBlocks );
-Analyzer_i *	CreateAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::MappedReader_c * pReader, const common::Filter_t & tSettings, bool bHaveMatchingBlocks );
+ScanCursor_i *	CreateScanCursorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::FileReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID );
+ScanCursor_i *	CreateScanCursorUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::MappedReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID );
+ScanCursor_i *	CreateScanCursorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::FileReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID );
+ScanCursor_i *	CreateScanCursorUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::MappedReader_c * pReader, uint32_t tMinRowID, uint32_t tMaxRowID );
+
+GroupCounter_i * CreateGroupCounterUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::FileReader_c * pReader );
+GroupCounter_i * CreateGroupCounterUint32 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::MappedReader_c * pReader );
+GroupCounter_i * CreateGroupCounterUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::FileReader_c * pReader );
+GroupCounter_i * CreateGroupCounterUint64 ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::MappedReader_c * pReader );
+
+Analyzer_i *	CreateAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::FileReader_c * pReader, const common::Filter_t & tSettings, bool bHaveMatchingBlocks );
+Analyzer_i *	CreateAnalyzerInt ( const AttributeHeader_i & tHeader, uint32_t uVersion, SubblockCache_c * pCache, util::MappedReader_c * pReader, const common::Filter_t & tSettings, bool bHaveMatchingBlocks );
 
 Checker_i *		CreateCheckerInt ( const AttributeHeader_i & tHeader, util::FileReader_c * pReader, Reporter_fn & fnProgress, Reporter_fn & fnError );
 
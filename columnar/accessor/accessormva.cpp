@@ -21,6 +21,7 @@
 #include "check.h"
 
 #include <algorithm>
+#include <unordered_map>
 
 namespace columnar
 {
@@ -275,6 +276,7 @@ public:
 private:
 	SpanResizeable_T<uint32_t>	m_dSubblockCumulativeSizes;
 	SpanResizeable_T<uint32_t>	m_dTmp;
+	SubblockCodecs_c			m_tCodecs;
 
 	SpanResizeable_T<T>			m_dValues;
 	std::vector<Span_T<T>>		m_dValuePtrs;
@@ -288,6 +290,7 @@ private:
 template <typename T, bool COMPRESSED>
 StoredBlock_MvaConstLen_T<T,COMPRESSED>::StoredBlock_MvaConstLen_T ( const std::string & sCodec32, const std::string & sCodec64, uint32_t uVersion )
 	: StoredBlock_Mva_c ( sCodec32, sCodec64, uVersion )
+	, m_tCodecs ( sCodec32, sCodec64, uVersion )
 {}
 
 template <typename T, bool COMPRESSED>
@@ -303,6 +306,10 @@ void StoredBlock_MvaConstLen_T<T,COMPRESSED>::ReadHeader ( RD & tReader, int iNu
 	uint32_t uSubblockSize = tReader.Unpack_uint32();
 	DecodeValues_Delta_PFOR ( m_dSubblockCumulativeSizes, tReader, *m_pCodec, m_dTmp, uSubblockSize, false, m_uVersion );
 
+	// non-compressed blocks have no codecs to choose from
+	if constexpr ( COMPRESSED )
+		m_tCodecs.ReadHeader ( tReader, iNumSubblocks );
+
 	m_tValuesOffset = tReader.GetPos();
 	m_iSubblockId = -1;
 }
@@ -360,7 +367,7 @@ void StoredBlock_MvaConstLen_T<T,COMPRESSED>::ReadSubblock ( int iSubblockId, in
 	else
 	{
 		m_dValues.resize(iValuesInSubblock);
-		DecodeValues_PFOR ( m_dValues, tReader, *m_pCodec, m_dTmp, uSize );
+		DecodeValues_PFOR ( m_dValues, tReader, m_tCodecs.Get(iSubblockId), m_dTmp, uSize );
 	}
 
 	PrecalcSizeOffset(iNumSubblockValues);
@@ -496,6 +503,7 @@ public:
 private:
 	SpanResizeable_T<uint32_t>	m_dSubblockCumulativeSizes;
 	SpanResizeable_T<uint32_t>	m_dTmp;
+	SubblockCodecs_c			m_tCodecs;
 
 	SpanResizeable_T<uint32_t>	m_dLengths;
 	SpanResizeable_T<T>			m_dValues;
@@ -505,6 +513,7 @@ private:
 template <typename T>
 StoredBlock_MvaPFOR_T<T>::StoredBlock_MvaPFOR_T ( const std::string & sCodec32, const std::string & sCodec64, uint32_t uVersion  )
 	: StoredBlock_Mva_c ( sCodec32, sCodec64, uVersion )
+	, m_tCodecs ( sCodec32, sCodec64, uVersion )
 {}
 
 template <typename T>
@@ -517,6 +526,7 @@ void StoredBlock_MvaPFOR_T<T>::ReadHeader ( RD & tReader, int iNumSubblocks )
 
 	uint32_t uSubblockSize = tReader.Unpack_uint32();
 	DecodeValues_Delta_PFOR ( m_dSubblockCumulativeSizes, tReader, *m_pCodec, m_dTmp, uSubblockSize, false, m_uVersion );
+	m_tCodecs.ReadHeader ( tReader, iNumSubblocks );
 
 	m_tValuesOffset = tReader.GetPos();
 	m_iSubblockId = -1;
@@ -545,15 +555,16 @@ void StoredBlock_MvaPFOR_T<T>::ReadSubblock ( int iSubblockId, int iSubblockValu
 	uint32_t uSize1 = tReader.Unpack_uint32();
 	int64_t iDelta  = tReader.GetPos()-iOffset;
 
+	util::IntCodec_c & tCodec = m_tCodecs.Get(iSubblockId);
 	m_dLengths.resize(iSubblockValues);
-	DecodeValues_PFOR ( m_dLengths, tReader, *m_pCodec, m_dTmp, uSize1 );
+	DecodeValues_PFOR ( m_dLengths, tReader, tCodec, m_dTmp, uSize1 );
 	uint32_t uTotalLength = 0;
 	for ( auto i : m_dLengths )
 		uTotalLength += i;
 
 	m_dValues.resize(uTotalLength);
 	if ( uTotalLength )
-		DecodeValues_PFOR ( m_dValues, tReader, *m_pCodec, m_dTmp, uint32_t ( uSize-uSize1-iDelta ) );
+		DecodeValues_PFOR ( m_dValues, tReader, tCodec, m_dTmp, uint32_t ( uSize-uSize1-iDelta ) );
 
 	PrecalcSizeOffset ( m_dLengths, m_dValues, m_dValuePtrs );
 
@@ -578,8 +589,11 @@ class Accessor_MVA_T : public StoredBlockTraits_t
 
 public:
 									Accessor_MVA_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader );
+									~Accessor_MVA_T() { UpdateCounters ( *m_pReader, m_tHeader, 0 ); }
 
 	FORCE_INLINE void				SetCurBlock ( uint32_t uBlockId );
+	FORCE_INLINE void				PrefetchBlock ( int iBlock ) const	{ PrefetchBlockData ( *m_pReader, m_tHeader, iBlock ); }
+	FORCE_INLINE int				GetNumBlocks() const				{ return m_tHeader.GetNumBlocks(); }
 
 protected:
 	const AttributeHeader_i &		m_tHeader;
@@ -636,6 +650,7 @@ Accessor_MVA_T<T,BUFFERED,RD>::Accessor_MVA_T ( const AttributeHeader_i & tHeade
 template <typename T, bool BUFFERED, typename RD>
 void Accessor_MVA_T<T,BUFFERED,RD>::SetCurBlock ( uint32_t uBlockId )
 {
+	UpdateCounters ( *m_pReader, m_tHeader, 1 );
 	m_pReader->Seek ( m_tHeader.GetBlockOffset(uBlockId) );
 	m_ePacking = (MvaPacking_e)m_pReader->Unpack_uint32();
 
@@ -709,10 +724,16 @@ class Iterator_MVA_T : public Iterator_i, public Accessor_MVA_T<T,BUFFERED,RD>
 
 public:
 	int64_t		Get ( uint32_t tRowID ) final						{ assert ( 0 && "INTERNAL ERROR: requesting int from MVA iterator" ); return 0; }
-	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch int from MVA iterator" ); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch int from MVA iterator" ); FillZeroes(dValues); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<uint32_t> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch int from MVA iterator" ); FillZeroes(dValues); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<float> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch float from MVA iterator" ); FillZeroes(dValues); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<uint8_t> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch bool from MVA iterator" ); FillZeroes(dValues); }
 	int			Get ( uint32_t tRowID, const uint8_t * & pData ) final;
 	uint8_t *	GetPacked ( uint32_t tRowID ) final;
+	uint8_t *	GetPacked ( uint32_t tRowID, PackedArena_i & tArena ) final;
 	int			GetLength ( uint32_t tRowID ) final;
+	void		FetchStrings ( const Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets ) final { assert ( 0 && "INTERNAL ERROR: requesting batch strings from MVA iterator" ); }
+	void		FetchMva ( const Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets ) final;
 
 	void		AddDesc ( std::vector<IteratorDesc_t> & dDesc ) const final { dDesc.push_back ( { BASE::m_tHeader.GetName(), "iterator" } ); }
 
@@ -763,6 +784,36 @@ uint8_t * Iterator_MVA_T<T,BUFFERED,RD>::GetPacked ( uint32_t tRowID )
 	return pData;
 }
 
+template <typename T, bool BUFFERED, typename RD>
+uint8_t * Iterator_MVA_T<T,BUFFERED,RD>::GetPacked ( uint32_t tRowID, PackedArena_i & tArena )
+{
+	// the unpacked value points to the decoded subblock, so it is copied to the arena right away
+	const uint8_t * pData = nullptr;
+	int iLength = Get ( tRowID, pData );
+	return PackValue ( pData, iLength, tArena );
+}
+
+template <typename T, bool BUFFERED, typename RD>
+void Iterator_MVA_T<T,BUFFERED,RD>::FetchMva ( const Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets )
+{
+	assert ( std::is_sorted ( dRowIDs.begin(), dRowIDs.end() ) );
+
+	dBlob.resize(0);
+	dOffsets.resize(0);
+	dOffsets.reserve ( dRowIDs.size()+1 );
+	dOffsets.push_back(0);
+
+	// subblocks keep their decoded values, so sorted rowids decode each subblock once
+	for ( auto tRowID : dRowIDs )
+	{
+		AdvanceTo(tRowID);
+		(*this.*BASE::m_fnReadValue)();
+		AppendBlobValue ( Span_T<uint8_t> ( BASE::m_pResult, BASE::m_tValueLength ), dBlob, dOffsets );
+	}
+
+	BASE::m_pResult = nullptr;
+}
+
 template <typename T, bool BUFFERED, typename RD>
 int Iterator_MVA_T<T,BUFFERED,RD>::GetLength ( uint32_t tRowID )
 {
@@ -774,6 +825,102 @@ int Iterator_MVA_T<T,BUFFERED,RD>::GetLength ( uint32_t tRowID )
 
 //////////////////////////////////////////////////////////////////////////
 
+template <typename T, typename RD>
+class GroupCounter_MVA_T : public GroupCounter_i, public Accessor_MVA_T<T,true,RD>
+{
+	using BASE = Accessor_MVA_T<T,true,RD>;
+	using BASE::Accessor_MVA_T;
+
+public:
+	void		Count ( uint32_t tMinRowID, uint32_t tMaxRowID ) final;
+	void		GetGroups ( std::vector<GroupCount_t> & dGroups ) const final;
+
+private:
+	std::unordered_map<int64_t,int64_t>	m_hCounts;
+
+	void		CountBlock ( uint32_t uStartInBlock, uint32_t uEndInBlock );
+	FORCE_INLINE void AddValue ( const T * pValue, size_t tLength, int64_t iCount );
+};
+
+template <typename T, typename RD>
+void GroupCounter_MVA_T<T,RD>::Count ( uint32_t tMinRowID, uint32_t tMaxRowID )
+{
+	ForEachBlock ( tMinRowID, std::min ( tMaxRowID, BASE::m_tHeader.GetNumDocs() ), [this]( uint32_t uBlockId, uint32_t uStartInBlock, uint32_t uEndInBlock )
+		{
+			if ( uBlockId!=BASE::m_uBlockId )
+				BASE::SetCurBlock(uBlockId);
+
+			CountBlock ( uStartInBlock, uEndInBlock );
+		} );
+}
+
+template <typename T, typename RD>
+void GroupCounter_MVA_T<T,RD>::CountBlock ( uint32_t uStartInBlock, uint32_t uEndInBlock )
+{
+	switch ( BASE::m_ePacking )
+	{
+	case MvaPacking_e::CONST:
+		BASE::template ReadValue_Const<false>();
+		AddValue ( (const T*)BASE::m_pResult, BASE::m_tValueLength/sizeof(T), uEndInBlock-uStartInBlock );
+		break;
+
+	case MvaPacking_e::TABLE:
+	{
+		// count codes over the whole range first; each table entry is expanded once per block
+		auto & tBlockTable = BASE::m_tBlockTable;
+		CodeCounts_t dCounts {};
+		BASE::ForEachSubblock ( uStartInBlock, uEndInBlock, [this, &dCounts, &tBlockTable]( int iSubblockId, int iNumValues, int iStart, int iEnd )
+			{
+				tBlockTable.template ReadSubblock<true> ( iSubblockId, iNumValues, *BASE::m_pReader );
+				const uint32_t * pIndexes = tBlockTable.GetValueIndexes().data();
+				CountCodes ( pIndexes+iStart, pIndexes+iEnd, dCounts );
+			} );
+
+		for ( int i = 0; i < tBlockTable.GetTableSize(); i++ )
+			if ( dCounts[i] )
+			{
+				auto tValue = tBlockTable.template GetValueFromTable<T> ( (uint8_t)i );
+				AddValue ( tValue.data(), tValue.size(), dCounts[i] );
+			}
+	}
+	break;
+
+	default:
+		for ( uint32_t i = uStartInBlock; i < uEndInBlock; i++ )
+		{
+			BASE::m_tRequestedRowID = BASE::m_tStartBlockRowId + i;
+			(*this.*BASE::m_fnReadValue)();
+			AddValue ( (const T*)BASE::m_pResult, BASE::m_tValueLength/sizeof(T), 1 );
+		}
+
+		BASE::m_pResult = nullptr;
+		break;
+	}
+}
+
+template <typename T, typename RD>
+void GroupCounter_MVA_T<T,RD>::AddValue ( const T * pValue, size_t tLength, int64_t iCount )
+{
+	for ( size_t i = 0; i < tLength; i++ )
+		m_hCounts[(int64_t)pValue[i]] += iCount;
+}
+
+template <typename T, typename RD>
+void GroupCounter_MVA_T<T,RD>::GetGroups ( std::vector<GroupCount_t> & dGroups ) const
+{
+	dGroups.resize(0);
+	dGroups.reserve ( m_hCounts.size() );
+	for ( const auto & i : m_hCounts )
+	{
+		GroupCount_t tGroup;
+		tGroup.m_iValue = i.first;
+		tGroup.m_iCount = i.second;
+		dGroups.push_back(tGroup);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 class AnalyzerBlock_MVA_c : public Filter_t
 {
 public:
@@ -1223,6 +1370,18 @@ static Iterator_i * NewIteratorMVA ( const AttributeHeader_i & tHeader, uint32_t
 Iterator_i * CreateIteratorMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, FileReader_c * pReader, bool bBuffered )		{ return NewIteratorMVA ( tHeader, uVersion, pReader, bBuffered ); }
 Iterator_i * CreateIteratorMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, MappedReader_c * pReader, bool bBuffered )	{ return NewIteratorMVA ( tHeader, uVersion, pReader, bBuffered ); }
 
+template <typename RD>
+static GroupCounter_i * NewGroupCounterMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader )
+{
+	if ( tHeader.GetType()==AttrType_e::UINT32SET )
+		return new GroupCounter_MVA_T<uint32_t,RD> ( tHeader, uVersion, pReader );
+
+	return new GroupCounter_MVA_T<uint64_t,RD> ( tHeader, uVersion, pReader );
+}
+
+GroupCounter_i * CreateGroupCounterMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, FileReader_c * pReader )		{ return NewGroupCounterMVA ( tHeader, uVersion, pReader ); }
+GroupCounter_i * CreateGroupCounterMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, MappedReader_c * pReader )	{ return NewGroupCounterMVA ( tHeader, uVersion, pReader ); }
+
 template <typename ANY, typename ALL, typename RD>
 static Analyzer_i * CreateAnalyzerMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader, const Filter_t & tSettings, bool bHaveMatchingBlocks )
 {
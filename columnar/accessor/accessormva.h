@@ -28,11 +28,14 @@ namespace columnar
 {
 
 class Analyzer_i;
+class GroupCounter_i;
 class Checker_i;
 class AttributeHeader_i;
 
 Iterator_i *	CreateIteratorMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::FileReader_c * pReader, bool bBuffered );
 Iterator_i *	CreateIteratorMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::MappedReader_c * pReader, bool bBuffered );
+GroupCounter_i * CreateGroupCounterMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::FileReader_c * pReader );
+GroupCounter_i * CreateGroupCounterMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::MappedReader_c * pReader );
 Analyzer_i *	CreateAnalyzerMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::FileReader_c * pReader, const common::Filter_t & tSettings, bool bHaveMatchingBlocks );
 Analyzer_i *	CreateAnalyzerMVA ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::MappedReader_c * pReader, const common::Filter_t & tSettings, bool bHaveMatchingBlocks );
 Checker_i *		CreateCheckerMva ( const AttributeHeader_i & tHeader, util::FileReader_c * pReader, Reporter_fn & fnProgress, Reporter_fn & fnError );
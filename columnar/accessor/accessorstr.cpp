@@ -20,6 +20,9 @@
 #include "reader.h"
 #include "check.h"
 
+#include <unordered_map>
+#include <cstring>
+
 namespace columnar
 {
 
@@ -154,6 +157,7 @@ Span_T<Span_T<uint8_t>> & StoredBlock_StrConstLen_c::ReadAllSubblockValues ( int
 {
 	int iIdInBlock = iSubblockIdInBlock*m_iSubblockSize;
 	tReader.Seek ( m_tValuesOffset + int64_t(iIdInBlock)*m_tValueLength );
+	m_iLastReadId = -1;
 
 	uint64_t uTotalLength = m_tValueLength*iSubblockValues;
 	uint8_t * pAllData = nullptr;
@@ -269,6 +273,80 @@ Span_T<uint8_t> StoredBlock_StrTable_c::GetValue ( int iIdInSubblock )
 
 //////////////////////////////////////////////////////////////////////////
 
+class StoredBlock_StrGlobal_c
+{
+public:
+							StoredBlock_StrGlobal_c ( const AttributeHeader_i & tHeader, int iSubblockSize );
+
+	template <typename RD> FORCE_INLINE void ReadHeader ( RD & tReader );
+	template <typename RD> FORCE_INLINE void ReadSubblock ( int iSubblockId, int iNumValues, RD & tReader );
+	FORCE_INLINE int		GetValueLength ( int iIdInSubblock ) const	{ return (int)m_tHeader.GetDictValue ( m_dValueIndexes[iIdInSubblock] ).size(); }
+	template <bool PACK>
+	FORCE_INLINE Span_T<uint8_t> GetValue ( int iIdInSubblock );
+
+	FORCE_INLINE Span_T<uint32_t> GetValueIndexes()						{ return m_tValuesRead; }
+
+private:
+	const AttributeHeader_i &	m_tHeader;
+	std::vector<uint32_t>		m_dValueIndexes;
+	std::vector<uint32_t>		m_dEncoded;
+	Span_T<uint32_t>			m_tValuesRead;
+
+	int64_t		m_iValuesOffset = 0;
+	int			m_iSubblockId = -1;
+	int			m_iBits = 0;
+};
+
+
+StoredBlock_StrGlobal_c::StoredBlock_StrGlobal_c ( const AttributeHeader_i & tHeader, int iSubblockSize )
+	: m_tHeader ( tHeader )
+{
+	m_dValueIndexes.resize(iSubblockSize);
+}
+
+
+template <typename RD>
+void StoredBlock_StrGlobal_c::ReadHeader ( RD & tReader )
+{
+	// the block stores the dictionary size it was written with; that defines the code width
+	uint32_t uDictSize = tReader.Unpack_uint32();
+	assert ( (int)uDictSize<=m_tHeader.GetNumDictValues() );
+
+	m_iBits = CalcNumBits(uDictSize);
+	m_dEncoded.resize ( ( m_dValueIndexes.size() >> 5 ) * m_iBits );
+
+	m_iValuesOffset = tReader.GetPos();
+	m_iSubblockId = -1;
+}
+
+
+template <typename RD>
+void StoredBlock_StrGlobal_c::ReadSubblock ( int iSubblockId, int iNumValues, RD & tReader )
+{
+	if ( m_iSubblockId==iSubblockId )
+		return;
+
+	m_iSubblockId = iSubblockId;
+
+	size_t uPackedSize = m_dEncoded.size()*sizeof ( m_dEncoded[0] );
+	tReader.Seek ( m_iValuesOffset + uPackedSize*iSubblockId );
+	tReader.Read ( (uint8_t*)m_dEncoded.data(), uPackedSize );
+	BitUnpack ( m_dEncoded, m_dValueIndexes, m_iBits );
+
+	m_tValuesRead = { m_dValueIndexes.data(), (size_t)iNumValues };
+}
+
+template <bool PACK>
+Span_T<uint8_t> StoredBlock_StrGlobal_c::GetValue ( int iIdInSubblock )
+{
+	Span_T<const uint8_t> tValue = m_tHeader.GetDictValue ( m_dValueIndexes[iIdInSubblock] );
+	uint8_t * pValue = nullptr;
+	uint32_t uLen = PackValue<uint8_t,PACK> ( Span_T<uint8_t> ( (uint8_t*)tValue.data(), tValue.size() ), pValue );
+	return {pValue, uLen};
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 class StoredBlock_StrGeneric_c
 {
 public:
@@ -387,6 +465,7 @@ Span_T<Span_T<uint8_t>> & StoredBlock_StrGeneric_c::ReadAllSubblockValues ( int
 
 	m_bValuesRead = true;
 	tReader.Seek(m_iFirstValueOffset);
+	m_iLastReadId = -1;
 
 	uint64_t uTotalLength = m_dCumulativeLengths.back();
 	uint8_t * pAllData = nullptr;
@@ -420,8 +499,11 @@ class Accessor_String_T : public StoredBlockTraits_t
 
 public:
 									Accessor_String_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader );
+									~Accessor_String_T() { UpdateCounters ( *m_pReader, m_tHeader, 0 ); }
 
 	FORCE_INLINE void				SetCurBlock ( uint32_t uBlockId );
+	FORCE_INLINE void				PrefetchBlock ( int iBlock ) const	{ PrefetchBlockData ( *m_pReader, m_tHeader, iBlock ); }
+	FORCE_INLINE int				GetNumBlocks() const				{ return m_tHeader.GetNumBlocks(); }
 
 protected:
 	const AttributeHeader_i &		m_tHeader;
@@ -432,6 +514,7 @@ protected:
 	StoredBlock_StrConstLen_c		m_tBlockConstLen;
 	StoredBlock_StrTable_c			m_tBlockTable;
 	StoredBlock_StrGeneric_c		m_tBlockGeneric;
+	StoredBlock_StrGlobal_c			m_tBlockGlobal;
 
 	Span_T<uint8_t>					m_tResult;
 
@@ -451,6 +534,9 @@ protected:
 	template <bool PACK> void ReadValue_Generic()	{ m_tResult = m_tBlockGeneric.template ReadValue<PACK>( ReadSubblock(m_tBlockGeneric), *m_pReader ); }
 	int			GetValueLen_Generic()				{ return m_tBlockGeneric.GetValueLength ( ReadSubblock(m_tBlockGeneric) ); }
 
+	template <bool PACK> void ReadValue_Global()	{ m_tResult = m_tBlockGlobal.template GetValue<PACK>( ReadSubblock(m_tBlockGlobal) ); }
+	int			GetValueLen_Global()				{ return m_tBlockGlobal.GetValueLength ( ReadSubblock(m_tBlockGlobal) ); }
+
 	template <typename T>
 	FORCE_INLINE int ReadSubblock ( T & tSubblock );
 };
@@ -464,6 +550,7 @@ Accessor_String_T<RD>::Accessor_String_T ( const AttributeHeader_i & tHeader, ui
 	, m_tBlockConstLen ( tHeader.GetSettings().m_iSubblockSize )
 	, m_tBlockTable ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64, uVersion, tHeader.GetSettings().m_iSubblockSize )
 	, m_tBlockGeneric ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64, uVersion )
+	, m_tBlockGlobal ( tHeader, tHeader.GetSettings().m_iSubblockSize )
 {
 	assert(pReader);
 }
@@ -472,6 +559,7 @@ Accessor_String_T<RD>::Accessor_String_T ( const AttributeHeader_i & tHeader, ui
 template <typename RD>
 void Accessor_String_T<RD>::SetCurBlock ( uint32_t uBlockId )
 {
+	UpdateCounters ( *m_pReader, m_tHeader, 1 );
 	m_pReader->Seek ( m_tHeader.GetBlockOffset(uBlockId) );
 	m_ePacking = (StrPacking_e)m_pReader->Unpack_uint32();
 
@@ -510,6 +598,13 @@ void Accessor_String_T<RD>::SetCurBlock ( uint32_t uBlockId )
 		m_tBlockGeneric.ReadHeader ( *m_pReader, m_iNumSubblocks );
 		break;
 
+	case StrPacking_e::GLOBAL:
+		m_fnReadValue			= &Accessor_String_T::ReadValue_Global<false>;
+		m_fnReadValuePacked		= &Accessor_String_T::ReadValue_Global<true>;
+		m_fnGetValueLength		= &Accessor_String_T::GetValueLen_Global;
+		m_tBlockGlobal.ReadHeader ( *m_pReader );
+		break;
+
 	default:
 		assert ( 0 && "Packing not implemented yet" );
 		break;
@@ -537,16 +632,23 @@ public:
 				Iterator_String_T ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader );
 
 	int64_t		Get ( uint32_t tRowID ) final						{ assert ( 0 && "INTERNAL ERROR: requesting int from string iterator" ); return 0; }
-	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch int from string iterator" ); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch int from string iterator" ); FillZeroes(dValues); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<uint32_t> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch int from string iterator" ); FillZeroes(dValues); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<float> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch float from string iterator" ); FillZeroes(dValues); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<uint8_t> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch bool from string iterator" ); FillZeroes(dValues); }
 
 	int			Get ( uint32_t tRowID, const uint8_t * & pData ) final;
 	uint8_t *	GetPacked ( uint32_t tRowID ) final;
+	uint8_t *	GetPacked ( uint32_t tRowID, PackedArena_i & tArena ) final;
 	int			GetLength ( uint32_t tRowID ) final;
+	void		FetchStrings ( const Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets ) final;
+	void		FetchMva ( const Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets ) final { assert ( 0 && "INTERNAL ERROR: requesting batch MVA from string iterator" ); }
 
 	void		AddDesc ( std::vector<IteratorDesc_t> & dDesc ) const final { dDesc.push_back ( { BASE::m_tHeader.GetName(), "iterator" } ); }
 
 private:
 	FORCE_INLINE void AdvanceTo ( uint32_t tRowID );
+	void		FetchSubblock ( const uint32_t * pRowID, const uint32_t * pRowIDEnd, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets );
 };
 
 
@@ -603,6 +705,123 @@ uint8_t * Iterator_String_T<RD>::GetPacked ( uint32_t tRowID )
 }
 
 
+template <typename RD>
+uint8_t * Iterator_String_T<RD>::GetPacked ( uint32_t tRowID, PackedArena_i & tArena )
+{
+	// the unpacked value points to the reader's buffer (or the mapping) and is copied to the arena right away
+	const uint8_t * pData = nullptr;
+	int iLength = Get ( tRowID, pData );
+	return PackValue ( pData, iLength, tArena );
+}
+
+
+template <typename RD>
+void Iterator_String_T<RD>::FetchStrings ( const Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets )
+{
+	assert ( std::is_sorted ( dRowIDs.begin(), dRowIDs.end() ) );
+
+	dBlob.resize(0);
+	dOffsets.resize(0);
+	dOffsets.reserve ( dRowIDs.size()+1 );
+	dOffsets.push_back(0);
+
+	const uint32_t * pRowID = dRowIDs.begin();
+	const uint32_t * pRowIDEnd = dRowIDs.end();
+	int iSubblockShift = BASE::m_iSubblockShift;
+
+	while ( pRowID<pRowIDEnd )
+	{
+		uint32_t tRowID = *pRowID;
+		assert ( tRowID < BASE::m_tHeader.GetNumDocs() );
+
+		uint32_t uBlockId = RowId2BlockId(tRowID);
+		if ( uBlockId!=BASE::m_uBlockId )
+			BASE::SetCurBlock(uBlockId);
+
+		uint32_t uSubblock = tRowID >> iSubblockShift;
+		const uint32_t * pSubblockEnd = pRowID+1;
+		while ( pSubblockEnd<pRowIDEnd && ( *pSubblockEnd >> iSubblockShift )==uSubblock )
+			pSubblockEnd++;
+
+		FetchSubblock ( pRowID, pSubblockEnd, dBlob, dOffsets );
+		pRowID = pSubblockEnd;
+	}
+
+	BASE::m_tResult = { nullptr, 0 };
+}
+
+
+template <typename RD>
+void Iterator_String_T<RD>::FetchSubblock ( const uint32_t * pRowID, const uint32_t * pRowIDEnd, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets )
+{
+	uint32_t uIdInBlock = *pRowID - BASE::m_tStartBlockRowId;
+	int iSubblockId = BASE::GetSubblockId(uIdInBlock);
+	int iNumValues = BASE::GetNumSubblockValues(iSubblockId);
+	uint32_t tSubblockStart = BASE::m_tStartBlockRowId + BASE::SubblockId2RowId(iSubblockId);
+
+	// reading the whole subblock in one go pays off only when a good part of it is requested
+	const int WHOLE_SUBBLOCK_RATIO = 4;
+	bool bReadAll = ( pRowIDEnd-pRowID )*WHOLE_SUBBLOCK_RATIO >= iNumValues;
+
+	switch ( BASE::m_ePacking )
+	{
+	case StrPacking_e::CONST:
+	{
+		Span_T<uint8_t> tValue = BASE::m_tBlockConst.template GetValue<false>();
+		for ( const uint32_t * p = pRowID; p<pRowIDEnd; p++ )
+			AppendBlobValue ( tValue, dBlob, dOffsets );
+	}
+	return;
+
+	case StrPacking_e::TABLE:
+		BASE::m_tBlockTable.ReadSubblock ( iSubblockId, iNumValues, *BASE::m_pReader );
+		for ( const uint32_t * p = pRowID; p<pRowIDEnd; p++ )
+			AppendBlobValue ( BASE::m_tBlockTable.template GetValue<false> ( *p - tSubblockStart ), dBlob, dOffsets );
+		return;
+
+	case StrPacking_e::GLOBAL:
+		BASE::m_tBlockGlobal.ReadSubblock ( iSubblockId, iNumValues, *BASE::m_pReader );
+		for ( const uint32_t * p = pRowID; p<pRowIDEnd; p++ )
+			AppendBlobValue ( BASE::m_tBlockGlobal.template GetValue<false> ( *p - tSubblockStart ), dBlob, dOffsets );
+		return;
+
+	case StrPacking_e::CONSTLEN:
+		if ( bReadAll )
+		{
+			auto & dValues = BASE::m_tBlockConstLen.ReadAllSubblockValues ( iSubblockId, iNumValues, *BASE::m_pReader );
+			for ( const uint32_t * p = pRowID; p<pRowIDEnd; p++ )
+				AppendBlobValue ( dValues[*p - tSubblockStart], dBlob, dOffsets );
+
+			return;
+		}
+		break;
+
+	case StrPacking_e::GENERIC:
+		if ( bReadAll )
+		{
+			BASE::m_tBlockGeneric.ReadSubblock ( iSubblockId, iNumValues, *BASE::m_pReader );
+			auto & dValues = BASE::m_tBlockGeneric.ReadAllSubblockValues ( iSubblockId, *BASE::m_pReader );
+			for ( const uint32_t * p = pRowID; p<pRowIDEnd; p++ )
+				AppendBlobValue ( dValues[*p - tSubblockStart], dBlob, dOffsets );
+
+			return;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	// sparse rowids; values are read one by one (consecutive ones without seeking)
+	for ( const uint32_t * p = pRowID; p<pRowIDEnd; p++ )
+	{
+		BASE::m_tRequestedRowID = *p;
+		(*this.*BASE::m_fnReadValue)();
+		AppendBlobValue ( BASE::m_tResult, dBlob, dOffsets );
+	}
+}
+
+
 template <typename RD>
 int Iterator_String_T<RD>::GetLength ( uint32_t tRowID )
 {
@@ -614,21 +833,179 @@ int Iterator_String_T<RD>::GetLength ( uint32_t tRowID )
 
 //////////////////////////////////////////////////////////////////////////
 
+template <typename RD>
+class GroupCounter_String_T : public GroupCounter_i, public Accessor_String_T<RD>
+{
+	using BASE = Accessor_String_T<RD>;
+	using BASE::Accessor_String_T;
+
+public:
+	void		Count ( uint32_t tMinRowID, uint32_t tMaxRowID ) final;
+	void		GetGroups ( std::vector<GroupCount_t> & dGroups ) const final;
+
+private:
+	std::unordered_map<std::string,int64_t>	m_hCounts;
+	std::vector<int64_t>					m_dDictCounts;
+
+	void		CountBlock ( uint32_t uStartInBlock, uint32_t uEndInBlock );
+	template <typename T>
+	FORCE_INLINE void AddValue ( const Span_T<T> & tValue, int64_t iCount ) { m_hCounts[std::string ( (const char*)tValue.data(), tValue.size() )] += iCount; }
+};
+
+
+template <typename RD>
+void GroupCounter_String_T<RD>::Count ( uint32_t tMinRowID, uint32_t tMaxRowID )
+{
+	ForEachBlock ( tMinRowID, std::min ( tMaxRowID, BASE::m_tHeader.GetNumDocs() ), [this]( uint32_t uBlockId, uint32_t uStartInBlock, uint32_t uEndInBlock )
+		{
+			if ( uBlockId!=BASE::m_uBlockId )
+				BASE::SetCurBlock(uBlockId);
+
+			CountBlock ( uStartInBlock, uEndInBlock );
+		} );
+}
+
+
+template <typename RD>
+void GroupCounter_String_T<RD>::CountBlock ( uint32_t uStartInBlock, uint32_t uEndInBlock )
+{
+	switch ( BASE::m_ePacking )
+	{
+	case StrPacking_e::CONST:
+		AddValue ( BASE::m_tBlockConst.template GetValue<false>(), uEndInBlock-uStartInBlock );
+		break;
+
+	case StrPacking_e::TABLE:
+	{
+		// count codes over the whole range first; table strings are hashed once per block
+		auto & tBlockTable = BASE::m_tBlockTable;
+		CodeCounts_t dCounts {};
+		BASE::ForEachSubblock ( uStartInBlock, uEndInBlock, [this, &dCounts, &tBlockTable]( int iSubblockId, int iNumValues, int iStart, int iEnd )
+			{
+				tBlockTable.ReadSubblock ( iSubblockId, iNumValues, *BASE::m_pReader );
+				const uint32_t * pIndexes = tBlockTable.GetValueIndexes().data();
+				CountCodes ( pIndexes+iStart, pIndexes+iEnd, dCounts );
+			} );
+
+		for ( int i = 0; i < tBlockTable.GetTableSize(); i++ )
+			if ( dCounts[i] )
+				AddValue ( tBlockTable.GetTableValue(i), dCounts[i] );
+	}
+	break;
+
+	case StrPacking_e::GLOBAL:
+	{
+		// same as table, but the counts are indexed by the file-level dictionary codes
+		auto & tBlockGlobal = BASE::m_tBlockGlobal;
+		auto & dCounts = m_dDictCounts;
+		dCounts.resize ( BASE::m_tHeader.GetNumDictValues() );
+		std::fill ( dCounts.begin(), dCounts.end(), 0 );
+		BASE::ForEachSubblock ( uStartInBlock, uEndInBlock, [this, &dCounts, &tBlockGlobal]( int iSubblockId, int iNumValues, int iStart, int iEnd )
+			{
+				tBlockGlobal.ReadSubblock ( iSubblockId, iNumValues, *BASE::m_pReader );
+				const uint32_t * pIndexes = tBlockGlobal.GetValueIndexes().data();
+				CountCodes ( pIndexes+iStart, pIndexes+iEnd, dCounts );
+			} );
+
+		for ( size_t i = 0; i < dCounts.size(); i++ )
+			if ( dCounts[i] )
+				AddValue ( BASE::m_tHeader.GetDictValue ( (int)i ), dCounts[i] );
+	}
+	break;
+
+	default:
+		for ( uint32_t i = uStartInBlock; i < uEndInBlock; i++ )
+		{
+			BASE::m_tRequestedRowID = BASE::m_tStartBlockRowId + i;
+			(*this.*BASE::m_fnReadValue)();
+			AddValue ( BASE::m_tResult, 1 );
+		}
+
+		BASE::m_tResult = { nullptr, 0 };
+		break;
+	}
+}
+
+
+template <typename RD>
+void GroupCounter_String_T<RD>::GetGroups ( std::vector<GroupCount_t> & dGroups ) const
+{
+	dGroups.resize(0);
+	dGroups.reserve ( m_hCounts.size() );
+	for ( const auto & i : m_hCounts )
+	{
+		GroupCount_t tGroup;
+		tGroup.m_sValue = i.first;
+		tGroup.m_iCount = i.second;
+		dGroups.push_back(tGroup);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+static FORCE_INLINE bool ContainsSubstring ( const uint8_t * pValue, size_t tLength, const std::vector<uint8_t> & dPattern )
+{
+	size_t tPatternLen = dPattern.size();
+	if ( !tPatternLen )
+		return true;
+
+	if ( tLength<tPatternLen )
+		return false;
+
+	// memchr for the first byte, then memcmp for the rest; both are vectorized in libc
+	const uint8_t * pEnd = pValue + tLength - tPatternLen + 1;
+	while ( pValue<pEnd )
+	{
+		pValue = (const uint8_t *)memchr ( pValue, dPattern[0], pEnd-pValue );
+		if ( !pValue )
+			return false;
+
+		if ( !memcmp ( pValue+1, dPattern.data()+1, tPatternLen-1 ) )
+			return true;
+
+		pValue++;
+	}
+
+	return false;
+}
+
+
 template <bool EQ>
 class AnalyzerBlock_Str_T : public Filter_t
 {
 public:
 				AnalyzerBlock_Str_T ( uint32_t & tRowID ) : m_tRowID ( tRowID ) {}
 
-	void		Setup ( const Filter_t & tSettings ) { *(Filter_t*)this = tSettings; }
+	void		Setup ( const Filter_t & tSettings );
 
 protected:
 	uint32_t &	m_tRowID;
+	size_t		m_tMinPatternLen = 0;
 
 	template <bool SINGLEVALUE, typename GETVALUE>
 	FORCE_INLINE bool CompareStrings ( int iId, uint64_t uLength, GETVALUE && fnGetValue );
+
+	template <bool PREFIX, typename T>
+	FORCE_INLINE bool MatchPattern ( const Span_T<T> & dValue ) const;
+
+	template <typename GETVALUE>
+	FORCE_INLINE bool Match ( int iId, uint64_t uLength, GETVALUE && fnGetValue );
 };
 
+template <bool EQ>
+void AnalyzerBlock_Str_T<EQ>::Setup ( const Filter_t & tSettings )
+{
+	*(Filter_t*)this = tSettings;
+
+	m_tMinPatternLen = 0;
+	if ( !m_dStringValues.empty() )
+	{
+		m_tMinPatternLen = m_dStringValues[0].size();
+		for ( const auto & i : m_dStringValues )
+			m_tMinPatternLen = std::min ( m_tMinPatternLen, i.size() );
+	}
+}
+
 template <bool EQ>
 template <bool SINGLEVALUE, typename GETVALUE>
 bool AnalyzerBlock_Str_T<EQ>::CompareStrings ( int iId, uint64_t uLength, GETVALUE && fnGetValue )
@@ -659,6 +1036,34 @@ bool AnalyzerBlock_Str_T<EQ>::CompareStrings ( int iId, uint64_t uLength, GETVAL
 	return false ^ (!EQ);
 }
 
+template <bool EQ>
+template <bool PREFIX, typename T>
+bool AnalyzerBlock_Str_T<EQ>::MatchPattern ( const Span_T<T> & dValue ) const
+{
+	for ( const auto & i : m_dStringValues )
+	{
+		if ( dValue.size()<i.size() )
+			continue;
+
+		if ( PREFIX ? ( i.empty() || !memcmp ( dValue.data(), i.data(), i.size() ) ) : ContainsSubstring ( dValue.data(), dValue.size(), i ) )
+			return true ^ (!EQ);
+	}
+
+	return false ^ (!EQ);
+}
+
+template <bool EQ>
+template <typename GETVALUE>
+bool AnalyzerBlock_Str_T<EQ>::Match ( int iId, uint64_t uLength, GETVALUE && fnGetValue )
+{
+	switch ( m_eType )
+	{
+	case FilterType_e::PREFIX:		return MatchPattern<true> ( fnGetValue(iId) );
+	case FilterType_e::CONTAINS:	return MatchPattern<false> ( fnGetValue(iId) );
+	default:						return CompareStrings<false> ( iId, uLength, fnGetValue );
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 template <bool EQ>
@@ -675,8 +1080,7 @@ public:
 template <bool EQ>
 bool AnalyzerBlock_Str_Const_T<EQ>::SetupNextBlock ( StoredBlock_StrConst_c & tBlock )
 {
-	assert ( BASE::m_eType==FilterType_e::STRINGS );
-	return BASE::template CompareStrings<false> ( 0, tBlock.GetValueLength(), [&tBlock](int){ return tBlock.GetValue<false>(); } );
+	return BASE::Match ( 0, tBlock.GetValueLength(), [&tBlock](int){ return tBlock.GetValue<false>(); } );
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -715,12 +1119,12 @@ int AnalyzerBlock_Str_Table_T<EQ>::ProcessSubblock ( uint32_t * & pRowID, const
 template <bool EQ>
 bool AnalyzerBlock_Str_Table_T<EQ>::SetupNextBlock ( const StoredBlock_StrTable_c & tBlock )
 {
-	assert ( BASE::m_eType==FilterType_e::STRINGS );
 	bool bAnythingMatches = false;
 
+	// table values are matched once per block
 	for ( int i = 0; i < tBlock.GetTableSize(); i++ )
 	{
-		m_dMap[i] = BASE::template CompareStrings<false> ( i, tBlock.GetTableValueLength(i), [&tBlock]( int iValue ){ return tBlock.GetTableValue(iValue); } );
+		m_dMap[i] = BASE::Match ( i, tBlock.GetTableValueLength(i), [&tBlock]( int iValue ){ return tBlock.GetTableValue(iValue); } );
 		bAnythingMatches |= m_dMap[i];
 	}
 
@@ -729,6 +1133,71 @@ bool AnalyzerBlock_Str_Table_T<EQ>::SetupNextBlock ( const StoredBlock_StrTable_
 
 //////////////////////////////////////////////////////////////////////////
 
+template <bool EQ>
+class AnalyzerBlock_Str_Global_T : public AnalyzerBlock_Str_T<EQ>
+{
+	using BASE = AnalyzerBlock_Str_T<EQ>;
+	using BASE::AnalyzerBlock_Str_T;
+
+public:
+	FORCE_INLINE int	ProcessSubblock ( uint32_t * & pRowID, const Span_T<uint32_t> & dValueIndexes );
+	FORCE_INLINE bool	SetupNextBlock ( const AttributeHeader_i & tHeader );
+
+private:
+	std::vector<uint8_t>	m_dMap;
+	bool					m_bAnythingMatches = false;
+	bool					m_bDictionaryReady = false;
+
+	void				SetupDictionary ( const AttributeHeader_i & tHeader );
+};
+
+template <bool EQ>
+bool AnalyzerBlock_Str_Global_T<EQ>::SetupNextBlock ( const AttributeHeader_i & tHeader )
+{
+	// columns without global blocks never pay for matching the dictionary
+	if ( !m_bDictionaryReady )
+	{
+		SetupDictionary(tHeader);
+		m_bDictionaryReady = true;
+	}
+
+	return m_bAnythingMatches;
+}
+
+template <bool EQ>
+void AnalyzerBlock_Str_Global_T<EQ>::SetupDictionary ( const AttributeHeader_i & tHeader )
+{
+	// dictionary values are matched once per query; blocks then only scan the codes
+	int iNumValues = tHeader.GetNumDictValues();
+	m_dMap.resize(iNumValues);
+	m_bAnythingMatches = false;
+	for ( int i = 0; i < iNumValues; i++ )
+	{
+		m_dMap[i] = BASE::Match ( i, tHeader.GetDictValue(i).size(), [&tHeader]( int iValue ){ return tHeader.GetDictValue(iValue); } );
+		m_bAnythingMatches |= !!m_dMap[i];
+	}
+}
+
+template <bool EQ>
+int AnalyzerBlock_Str_Global_T<EQ>::ProcessSubblock ( uint32_t * & pRowID, const Span_T<uint32_t> & dValueIndexes )
+{
+	uint32_t tRowID = BASE::m_tRowID;
+	const uint8_t * pMap = m_dMap.data();
+
+	for ( auto i : dValueIndexes )
+	{
+		if ( pMap[i] )
+			*pRowID++ = tRowID;
+
+		tRowID++;
+	}
+
+	BASE::m_tRowID = tRowID;
+	return (int)dValueIndexes.size();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 template <bool EQ>
 class AnalyzerBlock_Str_Values_T : public AnalyzerBlock_Str_T<EQ>
 {
@@ -738,6 +1207,9 @@ class AnalyzerBlock_Str_Values_T : public AnalyzerBlock_Str_T<EQ>
 public:
 	template <bool SINGLEVALUE, typename READVALUE>
 	FORCE_INLINE int	ProcessSubblock_Values ( uint32_t * & pRowID, const Span_T<uint64_t> & dLengths, READVALUE && fnReadValue );
+
+	template <bool PREFIX, typename READVALUES>
+	FORCE_INLINE int	ProcessSubblock_Pattern ( uint32_t * & pRowID, const Span_T<uint64_t> & dLengths, READVALUES && fnReadValues );
 };
 
 template <bool EQ>
@@ -758,6 +1230,36 @@ int AnalyzerBlock_Str_Values_T<EQ>::ProcessSubblock_Values ( uint32_t * & pRowID
 	return (int)dLengths.size();
 }
 
+template <bool EQ>
+template <bool PREFIX, typename READVALUES>
+int AnalyzerBlock_Str_Values_T<EQ>::ProcessSubblock_Pattern ( uint32_t * & pRowID, const Span_T<uint64_t> & dLengths, READVALUES && fnReadValues )
+{
+	// don't read values if all of them are shorter than the patterns
+	if ( std::none_of ( dLengths.begin(), dLengths.end(), [this]( uint64_t uLength ){ return uLength>=BASE::m_tMinPatternLen; } ) )
+	{
+		if ( EQ )
+		{
+			BASE::m_tRowID += (uint32_t)dLengths.size();
+			return (int)dLengths.size();
+		}
+
+		return FillWithIncreasingValues ( pRowID, dLengths.size(), BASE::m_tRowID );
+	}
+
+	uint32_t tRowID = BASE::m_tRowID;
+	const auto & dValues = fnReadValues();
+	for ( size_t i = 0; i < dLengths.size(); i++ )
+	{
+		if ( BASE::template MatchPattern<PREFIX> ( dValues[i] ) )
+			*pRowID++ = tRowID;
+
+		tRowID++;
+	}
+
+	BASE::m_tRowID = tRowID;
+	return (int)dLengths.size();
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 template <bool HAVE_MATCHING_BLOCKS, bool EQ, typename RD=util::FileReader_c>
@@ -775,6 +1277,7 @@ public:
 private:
 	AnalyzerBlock_Str_Const_T<EQ>	m_tBlockConst;
 	AnalyzerBlock_Str_Table_T<EQ>	m_tBlockTable;
+	AnalyzerBlock_Str_Global_T<EQ>	m_tBlockGlobal;
 	AnalyzerBlock_Str_Values_T<EQ>	m_tBlockValues;
 
 	const Filter_t &				m_tSettings;
@@ -787,8 +1290,11 @@ private:
 
 	int			ProcessSubblockConst ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	int			ProcessSubblockTable ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int			ProcessSubblockGlobal ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	template<bool SINGLEVALUE> int	ProcessSubblockConstLen ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	template<bool SINGLEVALUE> int	ProcessSubblockGeneric ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	template<bool PREFIX> int	ProcessSubblockConstLen_Pattern ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	template<bool PREFIX> int	ProcessSubblockGeneric_Pattern ( uint32_t * & pRowID, int iSubblockIdInBlock );
 
 	bool		MoveToBlock ( int iNextBlock ) final;
 };
@@ -799,11 +1305,13 @@ Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::Analyzer_String_T ( const Attribu
 	, ACCESSOR ( tHeader, uVersion, pReader )
 	, m_tBlockConst ( ANALYZER::m_tRowID )
 	, m_tBlockTable ( ANALYZER::m_tRowID )
+	, m_tBlockGlobal ( ANALYZER::m_tRowID )
 	, m_tBlockValues ( ANALYZER::m_tRowID )
 	, m_tSettings ( tSettings )
 {
 	m_tBlockConst.Setup(m_tSettings);
 	m_tBlockTable.Setup(m_tSettings);
+	m_tBlockGlobal.Setup(m_tSettings);
 	m_tBlockValues.Setup(m_tSettings);
 
 	SetupPackingFuncs();
@@ -827,6 +1335,7 @@ void Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::SetupPackingFuncs()
 
 	// doesn't depend on filter type too; work off pre-calculated array
 	dFuncs [ to_underlying ( StrPacking_e::TABLE ) ] = &Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockTable;
+	dFuncs [ to_underlying ( StrPacking_e::GLOBAL ) ] = &Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockGlobal;
 
 	switch ( m_tSettings.m_eType )
 	{
@@ -843,6 +1352,16 @@ void Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::SetupPackingFuncs()
 		}
 		break;
 
+	case FilterType_e::PREFIX:
+		dFuncs [ to_underlying ( StrPacking_e::CONSTLEN ) ]	= &Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockConstLen_Pattern<true>;
+		dFuncs [ to_underlying ( StrPacking_e::GENERIC ) ]	= &Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockGeneric_Pattern<true>;
+		break;
+
+	case FilterType_e::CONTAINS:
+		dFuncs [ to_underlying ( StrPacking_e::CONSTLEN ) ]	= &Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockConstLen_Pattern<false>;
+		dFuncs [ to_underlying ( StrPacking_e::GENERIC ) ]	= &Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockGeneric_Pattern<false>;
+		break;
+
 	default:
 		assert ( 0 && "Unsupported filter type" );
 		break;
@@ -862,6 +1381,13 @@ int Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockTable ( uint32
 	return m_tBlockTable.ProcessSubblock ( pRowID, ACCESSOR::m_tBlockTable.GetValueIndexes() );
 }
 
+template <bool HAVE_MATCHING_BLOCKS, bool EQ, typename RD>
+int Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockGlobal ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ACCESSOR::m_tBlockGlobal.ReadSubblock ( iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
+	return m_tBlockGlobal.ProcessSubblock ( pRowID, ACCESSOR::m_tBlockGlobal.GetValueIndexes() );
+}
+
 template <bool HAVE_MATCHING_BLOCKS, bool EQ, typename RD>
 template <bool SINGLEVALUE>
 int Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockConstLen ( uint32_t * & pRowID, int iSubblockIdInBlock )
@@ -893,6 +1419,27 @@ int Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockGeneric ( uint
 		} );
 }
 
+template <bool HAVE_MATCHING_BLOCKS, bool EQ, typename RD>
+template <bool PREFIX>
+int Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockConstLen_Pattern ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	int iNumSubblockValues = StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock);
+	ACCESSOR::m_tBlockConstLen.ReadSubblock ( iSubblockIdInBlock, iNumSubblockValues, *ACCESSOR::m_pReader );
+
+	return m_tBlockValues.template ProcessSubblock_Pattern<PREFIX> ( pRowID, ACCESSOR::m_tBlockConstLen.GetAllValueLengths(),
+		[iSubblockIdInBlock,iNumSubblockValues,this]() -> const Span_T<Span_T<uint8_t>> & { return ACCESSOR::m_tBlockConstLen.ReadAllSubblockValues ( iSubblockIdInBlock, iNumSubblockValues, *ACCESSOR::m_pReader ); } );
+}
+
+template <bool HAVE_MATCHING_BLOCKS, bool EQ, typename RD>
+template <bool PREFIX>
+int Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::ProcessSubblockGeneric_Pattern ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ACCESSOR::m_tBlockGeneric.ReadSubblock ( iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
+
+	return m_tBlockValues.template ProcessSubblock_Pattern<PREFIX> ( pRowID, ACCESSOR::m_tBlockGeneric.GetAllValueLengths(),
+		[iSubblockIdInBlock,this]() -> const Span_T<Span_T<uint8_t>> & { return ACCESSOR::m_tBlockGeneric.ReadAllSubblockValues ( iSubblockIdInBlock, *ACCESSOR::m_pReader ); } );
+}
+
 template <bool HAVE_MATCHING_BLOCKS, bool EQ, typename RD>
 bool Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::MoveToBlock ( int iNextBlock )
 {
@@ -900,20 +1447,18 @@ bool Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::MoveToBlock ( int iNextBlock
 	{
 		ANALYZER::StartBlockProcessing ( (ACCESSOR&)*this, iNextBlock );
 
-		if ( ACCESSOR::m_ePacking!=StrPacking_e::CONST && ACCESSOR::m_ePacking!=StrPacking_e::TABLE )
-			break;
-
-		if ( ACCESSOR::m_ePacking==StrPacking_e::CONST )
+		bool bAnythingMatches = true;
+		switch ( ACCESSOR::m_ePacking )
 		{
-			if ( m_tBlockConst.SetupNextBlock ( ACCESSOR::m_tBlockConst ) )
-				break;
-		}
-		else
-		{
-			if ( m_tBlockTable.SetupNextBlock ( ACCESSOR::m_tBlockTable ) )
-				break;
+		case StrPacking_e::CONST:	bAnythingMatches = m_tBlockConst.SetupNextBlock ( ACCESSOR::m_tBlockConst ); break;
+		case StrPacking_e::TABLE:	bAnythingMatches = m_tBlockTable.SetupNextBlock ( ACCESSOR::m_tBlockTable ); break;
+		case StrPacking_e::GLOBAL:	bAnythingMatches = m_tBlockGlobal.SetupNextBlock ( ACCESSOR::m_tHeader ); break;
+		default:					break;
 		}
 
+		if ( bAnythingMatches )
+			break;
+
 		if ( !ANALYZER::RewindToNextBlock ( (ACCESSOR&)*this, iNextBlock ) )
 			return false;
 	}
@@ -929,6 +1474,9 @@ bool Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ,RD>::MoveToBlock ( int iNextBlock
 Iterator_i * CreateIteratorStr ( const AttributeHeader_i & tHeader, uint32_t uVersion, FileReader_c * pReader )		{ return new Iterator_String_T<FileReader_c> ( tHeader, uVersion, pReader ); }
 Iterator_i * CreateIteratorStr ( const AttributeHeader_i & tHeader, uint32_t uVersion, MappedReader_c * pReader )		{ return new Iterator_String_T<MappedReader_c> ( tHeader, uVersion, pReader ); }
 
+GroupCounter_i * CreateGroupCounterStr ( const AttributeHeader_i & tHeader, uint32_t uVersion, FileReader_c * pReader )		{ return new GroupCounter_String_T<FileReader_c> ( tHeader, uVersion, pReader ); }
+GroupCounter_i * CreateGroupCounterStr ( const AttributeHeader_i & tHeader, uint32_t uVersion, MappedReader_c * pReader )	{ return new GroupCounter_String_T<MappedReader_c> ( tHeader, uVersion, pReader ); }
+
 
 template <typename RD>
 static Analyzer_i * NewAnalyzerStr ( const AttributeHeader_i & tHeader, uint32_t uVersion, RD * pReader, const Filter_t & tSettings, bool bHaveMatchingBlocks )
@@ -964,7 +1512,7 @@ private:
 bool Checker_String_c::CheckBlockHeader ( uint32_t uBlockId )
 {
 	uint32_t uPacking = m_pReader->Unpack_uint32();
-	if ( uPacking!=(uint32_t)StrPacking_e::CONST && uPacking!=(uint32_t)StrPacking_e::CONSTLEN && uPacking!=(uint32_t)StrPacking_e::TABLE && uPacking!=(uint32_t)StrPacking_e::GENERIC )
+	if ( uPacking!=(uint32_t)StrPacking_e::CONST && uPacking!=(uint32_t)StrPacking_e::CONSTLEN && uPacking!=(uint32_t)StrPacking_e::TABLE && uPacking!=(uint32_t)StrPacking_e::GENERIC && uPacking!=(uint32_t)StrPacking_e::GLOBAL )
 	{
 		m_fnError ( FormatStr ( "Unknown encoding of block %u: %u", uBlockId, uPacking ).c_str() );
 		return false;
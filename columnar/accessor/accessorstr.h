@@ -28,12 +28,15 @@ namespace columnar
 {
 
 class Iterator_i;
+class GroupCounter_i;
 class Analyzer_i;
 class Checker_i;
 class AttributeHeader_i;
 
 Iterator_i *	CreateIteratorStr ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::FileReader_c * pReader );
 Iterator_i *	CreateIteratorStr ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::MappedReader_c * pReader );
+GroupCounter_i * CreateGroupCounterStr ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::FileReader_c * pReader );
+GroupCounter_i * CreateGroupCounterStr ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::MappedReader_c * pReader );
 Analyzer_i *	CreateAnalyzerStr ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::FileReader_c * pReader, const common::Filter_t & tSettings, bool bHaveMatchingBlocks );
 Analyzer_i *	CreateAnalyzerStr ( const AttributeHeader_i & tHeader, uint32_t uVersion, util::MappedReader_c * pReader, const common::Filter_t & tSettings, bool bHaveMatchingBlocks );
 Checker_i *		CreateCheckerStr ( const AttributeHeader_i & tHeader, util::FileReader_c * pReader, Reporter_fn & fnProgress, Reporter_fn & fnError );
@@ -22,6 +22,8 @@
 #include "reader.h"
 #include "delta.h"
 #include <cassert>
+#include <array>
+#include <algorithm>
 
 namespace columnar
 {
@@ -98,9 +100,77 @@ struct StoredBlockTraits_t : SubblockCalc_t
 		int iLeftover = m_uNumDocsInBlock & (m_iSubblockSize-1);
 		return iLeftover ? iLeftover : m_iSubblockSize;
 	}
+
+	// calls fnProcess ( iSubblockId, iNumSubblockValues, iStart, iEnd ) for every subblock intersecting [uStartInBlock, uEndInBlock)
+	template <typename FN>
+	FORCE_INLINE void ForEachSubblock ( uint32_t uStartInBlock, uint32_t uEndInBlock, FN && fnProcess ) const
+	{
+		while ( uStartInBlock < uEndInBlock )
+		{
+			int iSubblockId = GetSubblockId(uStartInBlock);
+			int iNumValues = GetNumSubblockValues(iSubblockId);
+			int iStart = GetValueIdInSubblock(uStartInBlock);
+			int iEnd = (int)std::min ( (uint32_t)iNumValues, uEndInBlock - SubblockId2RowId(iSubblockId) );
+			fnProcess ( iSubblockId, iNumValues, iStart, iEnd );
+			uStartInBlock += iEnd-iStart;
+		}
+	}
 };
 
+// calls fnProcess ( uBlockId, uStartInBlock, uEndInBlock ) for every block intersecting [tMinRowID, tMaxRowID)
+template <typename FN>
+FORCE_INLINE void ForEachBlock ( uint32_t tMinRowID, uint32_t tMaxRowID, FN && fnProcess )
+{
+	while ( tMinRowID < tMaxRowID )
+	{
+		uint32_t uBlockId = RowId2BlockId(tMinRowID);
+		uint32_t tBlockStart = BlockId2RowId(uBlockId);
+		uint32_t uEndInBlock = (uint32_t)std::min ( (uint64_t)DOCS_PER_BLOCK, (uint64_t)tMaxRowID - tBlockStart );
+		fnProcess ( uBlockId, tMinRowID-tBlockStart, uEndInBlock );
+		tMinRowID = tBlockStart + uEndInBlock;
+	}
+}
+
+using CodeCounts_t = std::array<int64_t,256>;
+
+// table and dictionary codes are dense, so counting them is a flat array increment
+template <typename COUNTS>
+FORCE_INLINE void CountCodes ( const uint32_t * pIndex, const uint32_t * pIndexEnd, COUNTS & dCounts )
+{
+	for ( ; pIndex < pIndexEnd; pIndex++ )
+		dCounts[*pIndex]++;
+}
+
+// number of blocks that analyzers and scan cursors announce ahead of decoding
+static const int PREFETCH_BLOCKS = 4;
+
+// asks the reader to start fetching the block data; decoding then doesn't wait on every buffer refill
+template <typename RD>
+FORCE_INLINE void PrefetchBlockData ( const RD & tReader, const AttributeHeader_i & tHeader, int iBlock )
+{
+	// we don't know where the last block ends; the cap also keeps huge blocks from flooding the page cache
+	const int64_t MAX_PREFETCH_SIZE = 4*1024*1024;
+
+	int64_t iStart = (int64_t)tHeader.GetBlockOffset(iBlock);
+	int64_t iLength = iBlock+1<tHeader.GetNumBlocks() ? (int64_t)tHeader.GetBlockOffset(iBlock+1)-iStart : MAX_PREFETCH_SIZE;
+	tReader.Prefetch ( iStart, std::min ( iLength, MAX_PREFETCH_SIZE ) );
+}
+
+// moves the bytes read so far to the attribute's shared counters; called once per block, so the atomics are not contended
+template <typename RD>
+FORCE_INLINE void UpdateCounters ( RD & tReader, const AttributeHeader_i & tHeader, int iBlocksDecoded )
+{
+	AttributeCounters_t & tCounters = tHeader.GetCounters();
+	if ( iBlocksDecoded )
+		tCounters.m_iBlocksDecoded.fetch_add ( iBlocksDecoded, std::memory_order_relaxed );
+
+	int64_t iBytesRead = tReader.FlushBytesRead();
+	if ( iBytesRead )
+		tCounters.m_iBytesRead.fetch_add ( iBytesRead, std::memory_order_relaxed );
+}
+
 // common traits of all columnar analyzers
+
 template <bool HAVE_MATCHING_BLOCKS>
 class Analyzer_T : public Analyzer_i
 {
@@ -121,6 +191,7 @@ protected:
 	int			m_iCurBlockId = -1;
 	int			m_iTotalSubblocks = 0;
 	int			m_iRowsLeft = INT_MAX;
+	int			m_iPrefetchedBlock = -1;
 
 	std::vector<uint32_t> m_dCollected {0};
 	SharedBlocks_c		m_pMatchingSubblocks;
@@ -138,6 +209,9 @@ protected:
 
 	template <typename ACCESSOR>
 	FORCE_INLINE bool	RewindToNextBlock ( ACCESSOR & tAccessor, int & iNextBlock );
+
+	template <typename ACCESSOR>
+	FORCE_INLINE void	PrefetchBlocks ( ACCESSOR & tAccessor, int iBlock );
 };
 
 template <bool HAVE_MATCHING_BLOCKS>
@@ -248,10 +322,39 @@ template <bool HAVE_MATCHING_BLOCKS>
 template <typename ACCESSOR>
 void Analyzer_T<HAVE_MATCHING_BLOCKS>::StartBlockProcessing ( ACCESSOR & tAccessor, int iNextBlock )
 {
+	PrefetchBlocks ( tAccessor, iNextBlock );
 	m_iCurBlockId = iNextBlock;
 	tAccessor.SetCurBlock ( m_iCurBlockId );
 }
 
+template <bool HAVE_MATCHING_BLOCKS>
+template <typename ACCESSOR>
+void Analyzer_T<HAVE_MATCHING_BLOCKS>::PrefetchBlocks ( ACCESSOR & tAccessor, int iBlock )
+{
+	// announce the current block and the next few ones that have matching subblocks
+	int iNumBlocks = tAccessor.GetNumBlocks();
+	int iSubblock = m_iCurSubblock;
+	for ( int i = 0; i < PREFETCH_BLOCKS && iBlock<iNumBlocks; i++ )
+	{
+		if ( iBlock>m_iPrefetchedBlock )
+		{
+			tAccessor.PrefetchBlock(iBlock);
+			m_iPrefetchedBlock = iBlock;
+		}
+
+		if constexpr ( HAVE_MATCHING_BLOCKS )
+		{
+			iSubblock = m_pMatchingSubblocks->Find ( iSubblock, ( iBlock+1 )*m_tSubblockCalc.m_iSubblocksPerBlock );
+			if ( iSubblock>=m_iTotalSubblocks )
+				break;
+
+			iBlock = m_tSubblockCalc.SubblockId2BlockId ( m_pMatchingSubblocks->GetBlock(iSubblock) );
+		}
+		else
+			iBlock++;
+	}
+}
+
 template <bool HAVE_MATCHING_BLOCKS>
 template <typename ACCESSOR>
 bool Analyzer_T<HAVE_MATCHING_BLOCKS>::RewindToNextBlock ( ACCESSOR & tAccessor, int & iNextBlock )
@@ -324,6 +427,355 @@ FORCE_INLINE void AddMinValue ( util::Span_T<uint64_t> & dValues, uint64_t uMin
 }
 
 
+// copies values of rowids that belong to a single decoded subblock; tSubblockStart is the rowid of the 1st value in pValues
+template <typename T, typename DST>
+FORCE_INLINE void GatherValues ( const T * pValues, uint32_t tSubblockStart, const uint32_t * pRowID, const uint32_t * pRowIDEnd, DST * pDst )
+{
+	for ( ; pRowID<pRowIDEnd; pRowID++ )
+		*pDst++ = (DST)pValues [ *pRowID - tSubblockStart ];
+}
+
+#if defined(USE_AVX2) || defined(USE_AVX512)
+FORCE_INLINE void GatherValues ( const uint32_t * pValues, uint32_t tSubblockStart, const uint32_t * pRowID, const uint32_t * pRowIDEnd, int64_t * pDst )
+{
+	__m256i tStart = _mm256_set1_epi32 ( (int)tSubblockStart );
+	for ( ; pRowID+8<=pRowIDEnd; pRowID+=8, pDst+=8 )
+	{
+		__m256i tIndexes = _mm256_sub_epi32 ( _mm256_loadu_si256 ( (const __m256i*)pRowID ), tStart );
+		__m256i tGathered = _mm256_i32gather_epi32 ( (const int*)pValues, tIndexes, sizeof(uint32_t) );
+		_mm256_storeu_si256 ( (__m256i*)pDst, _mm256_cvtepu32_epi64 ( _mm256_castsi256_si128(tGathered) ) );
+		_mm256_storeu_si256 ( (__m256i*)(pDst+4), _mm256_cvtepu32_epi64 ( _mm256_extracti128_si256 ( tGathered, 1 ) ) );
+	}
+
+	GatherValues<uint32_t,int64_t> ( pValues, tSubblockStart, pRowID, pRowIDEnd, pDst );
+}
+
+
+FORCE_INLINE void GatherValues ( const uint32_t * pValues, uint32_t tSubblockStart, const uint32_t * pRowID, const uint32_t * pRowIDEnd, uint32_t * pDst )
+{
+	__m256i tStart = _mm256_set1_epi32 ( (int)tSubblockStart );
+	for ( ; pRowID+8<=pRowIDEnd; pRowID+=8, pDst+=8 )
+	{
+		__m256i tIndexes = _mm256_sub_epi32 ( _mm256_loadu_si256 ( (const __m256i*)pRowID ), tStart );
+		_mm256_storeu_si256 ( (__m256i*)pDst, _mm256_i32gather_epi32 ( (const int*)pValues, tIndexes, sizeof(uint32_t) ) );
+	}
+
+	GatherValues<uint32_t,uint32_t> ( pValues, tSubblockStart, pRowID, pRowIDEnd, pDst );
+}
+
+
+FORCE_INLINE void GatherValues ( const uint64_t * pValues, uint32_t tSubblockStart, const uint32_t * pRowID, const uint32_t * pRowIDEnd, int64_t * pDst )
+{
+	__m128i tStart = _mm_set1_epi32 ( (int)tSubblockStart );
+	for ( ; pRowID+4<=pRowIDEnd; pRowID+=4, pDst+=4 )
+	{
+		__m128i tIndexes = _mm_sub_epi32 ( _mm_loadu_si128 ( (const __m128i*)pRowID ), tStart );
+		_mm256_storeu_si256 ( (__m256i*)pDst, _mm256_i32gather_epi64 ( (const long long*)pValues, tIndexes, sizeof(uint64_t) ) );
+	}
+
+	GatherValues<uint64_t,int64_t> ( pValues, tSubblockStart, pRowID, pRowIDEnd, pDst );
+}
+#endif
+
+
+// range filter kernels for decoded subblocks; write matching rowids to pRowID and return the number of values processed
+// the caller handles the tail with the scalar RANGE_EVAL. the analyzer buffer holds 2 subblocks, so full-width stores stay in bounds
+#if defined(USE_AVX512)
+template <typename RANGE_EVAL>
+FORCE_INLINE __mmask16 RangeMask32_AVX512 ( __m512i tValues, __m512i tMin, __m512i tMax )
+{
+	__mmask16 tMask = 0xFFFF;
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_LEFT )
+		tMask &= _mm512_cmp_epu32_mask ( tValues, tMin, RANGE_EVAL::CLOSED_LEFT ? _MM_CMPINT_NLT : _MM_CMPINT_NLE );
+
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_RIGHT )
+		tMask &= _mm512_cmp_epu32_mask ( tValues, tMax, RANGE_EVAL::CLOSED_RIGHT ? _MM_CMPINT_LE : _MM_CMPINT_LT );
+
+	return tMask;
+}
+
+
+template <typename RANGE_EVAL>
+FORCE_INLINE __mmask16 RangeMaskFloat_AVX512 ( __m512 tValues, __m512 tMin, __m512 tMax )
+{
+	__mmask16 tMask = 0xFFFF;
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_LEFT )
+		tMask &= _mm512_cmp_ps_mask ( tValues, tMin, RANGE_EVAL::CLOSED_LEFT ? _CMP_GE_OQ : _CMP_GT_OQ );
+
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_RIGHT )
+		tMask &= _mm512_cmp_ps_mask ( tValues, tMax, RANGE_EVAL::CLOSED_RIGHT ? _CMP_LE_OQ : _CMP_LT_OQ );
+
+	return tMask;
+}
+
+
+template <typename RANGE_EVAL, bool SIGNED>
+FORCE_INLINE __mmask8 RangeMask64_AVX512 ( __m512i tValues, __m512i tMin, __m512i tMax )
+{
+	__mmask8 tMask = 0xFF;
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_LEFT )
+	{
+		if constexpr ( SIGNED )
+			tMask &= _mm512_cmp_epi64_mask ( tValues, tMin, RANGE_EVAL::CLOSED_LEFT ? _MM_CMPINT_NLT : _MM_CMPINT_NLE );
+		else
+			tMask &= _mm512_cmp_epu64_mask ( tValues, tMin, RANGE_EVAL::CLOSED_LEFT ? _MM_CMPINT_NLT : _MM_CMPINT_NLE );
+	}
+
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_RIGHT )
+	{
+		if constexpr ( SIGNED )
+			tMask &= _mm512_cmp_epi64_mask ( tValues, tMax, RANGE_EVAL::CLOSED_RIGHT ? _MM_CMPINT_LE : _MM_CMPINT_LT );
+		else
+			tMask &= _mm512_cmp_epu64_mask ( tValues, tMax, RANGE_EVAL::CLOSED_RIGHT ? _MM_CMPINT_LE : _MM_CMPINT_LT );
+	}
+
+	return tMask;
+}
+
+
+template <typename RANGE_EVAL, typename VALUES, typename T>
+FORCE_INLINE size_t FilterRange_SIMD ( const T * pValues, size_t tNumValues, VALUES tMin, VALUES tMax, uint32_t tRowID, uint32_t * & pRowID )
+{
+	size_t i = 0;
+	if constexpr ( sizeof(T)==sizeof(uint32_t) && ( std::is_same_v<VALUES,uint32_t> || std::is_same_v<VALUES,float> ) )
+	{
+		__m512i tRowIDs = _mm512_add_epi32 ( _mm512_set1_epi32 ( (int)tRowID ), _mm512_setr_epi32 ( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ) );
+		const __m512i tStep = _mm512_set1_epi32(16);
+		for ( ; i+16<=tNumValues; i+=16 )
+		{
+			__m512i tValues = _mm512_loadu_si512 ( pValues+i );
+			__mmask16 tMask;
+			if constexpr ( std::is_same_v<VALUES,float> )
+				tMask = RangeMaskFloat_AVX512<RANGE_EVAL> ( _mm512_castsi512_ps(tValues), _mm512_set1_ps(tMin), _mm512_set1_ps(tMax) );
+			else
+				tMask = RangeMask32_AVX512<RANGE_EVAL> ( tValues, _mm512_set1_epi32 ( (int)tMin ), _mm512_set1_epi32 ( (int)tMax ) );
+
+			_mm512_mask_compressstoreu_epi32 ( pRowID, tMask, tRowIDs );
+			pRowID += _mm_popcnt_u32(tMask);
+			tRowIDs = _mm512_add_epi32 ( tRowIDs, tStep );
+		}
+	}
+	else if constexpr ( sizeof(T)==sizeof(uint64_t) && ( std::is_same_v<VALUES,int64_t> || std::is_same_v<VALUES,uint64_t> ) )
+	{
+		__m256i tRowIDs = _mm256_add_epi32 ( _mm256_set1_epi32 ( (int)tRowID ), _mm256_setr_epi32 ( 0, 1, 2, 3, 4, 5, 6, 7 ) );
+		const __m256i tStep = _mm256_set1_epi32(8);
+		const __m512i tMinV = _mm512_set1_epi64 ( (long long)tMin );
+		const __m512i tMaxV = _mm512_set1_epi64 ( (long long)tMax );
+		for ( ; i+8<=tNumValues; i+=8 )
+		{
+			__mmask8 tMask = RangeMask64_AVX512<RANGE_EVAL, std::is_signed_v<VALUES>> ( _mm512_loadu_si512 ( pValues+i ), tMinV, tMaxV );
+			_mm256_mask_compressstoreu_epi32 ( pRowID, tMask, tRowIDs );
+			pRowID += _mm_popcnt_u32(tMask);
+			tRowIDs = _mm256_add_epi32 ( tRowIDs, tStep );
+		}
+	}
+
+	return i;
+}
+#elif defined(USE_AVX2)
+// lane permutations that move the rowids of set mask bits to the front of a 8x32 vector
+inline const uint32_t * GetCompactPermutations()
+{
+	static const std::array<uint32_t, 256*8> dPermutations = []
+	{
+		std::array<uint32_t, 256*8> dResult {};
+		for ( int iMask = 0; iMask < 256; iMask++ )
+		{
+			int iOut = 0;
+			for ( int iBit = 0; iBit < 8; iBit++ )
+				if ( iMask & ( 1<<iBit ) )
+					dResult[iMask*8 + iOut++] = iBit;
+		}
+
+		return dResult;
+	}();
+
+	return dPermutations.data();
+}
+
+
+template <typename RANGE_EVAL>
+FORCE_INLINE __m256i RangeMask32_AVX2 ( __m256i tValues, __m256i tMin, __m256i tMax )
+{
+	// no unsigned compares in AVX2; use min/max: v>=a <=> max(v,a)==v, v<=a <=> min(v,a)==v
+	__m256i tMask = _mm256_set1_epi32(-1);
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_LEFT )
+	{
+		if constexpr ( RANGE_EVAL::CLOSED_LEFT )
+			tMask = _mm256_cmpeq_epi32 ( _mm256_max_epu32 ( tValues, tMin ), tValues );
+		else
+			tMask = _mm256_andnot_si256 ( _mm256_cmpeq_epi32 ( _mm256_min_epu32 ( tValues, tMin ), tValues ), tMask );
+	}
+
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_RIGHT )
+	{
+		if constexpr ( RANGE_EVAL::CLOSED_RIGHT )
+			tMask = _mm256_and_si256 ( tMask, _mm256_cmpeq_epi32 ( _mm256_min_epu32 ( tValues, tMax ), tValues ) );
+		else
+			tMask = _mm256_andnot_si256 ( _mm256_cmpeq_epi32 ( _mm256_max_epu32 ( tValues, tMax ), tValues ), tMask );
+	}
+
+	return tMask;
+}
+
+
+template <typename RANGE_EVAL>
+FORCE_INLINE __m256 RangeMaskFloat_AVX2 ( __m256 tValues, __m256 tMin, __m256 tMax )
+{
+	__m256 tMask = _mm256_castsi256_ps ( _mm256_set1_epi32(-1) );
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_LEFT )
+		tMask = _mm256_cmp_ps ( tValues, tMin, RANGE_EVAL::CLOSED_LEFT ? _CMP_GE_OQ : _CMP_GT_OQ );
+
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_RIGHT )
+		tMask = _mm256_and_ps ( tMask, _mm256_cmp_ps ( tValues, tMax, RANGE_EVAL::CLOSED_RIGHT ? _CMP_LE_OQ : _CMP_LT_OQ ) );
+
+	return tMask;
+}
+
+
+// signed compare; unsigned values are expected to have their sign bits flipped
+template <typename RANGE_EVAL>
+FORCE_INLINE __m256i RangeMask64_AVX2 ( __m256i tValues, __m256i tMin, __m256i tMax )
+{
+	__m256i tMask = _mm256_set1_epi32(-1);
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_LEFT )
+	{
+		if constexpr ( RANGE_EVAL::CLOSED_LEFT )
+			tMask = _mm256_andnot_si256 ( _mm256_cmpgt_epi64 ( tMin, tValues ), tMask );
+		else
+			tMask = _mm256_cmpgt_epi64 ( tValues, tMin );
+	}
+
+	if constexpr ( !RANGE_EVAL::UNBOUNDED_RIGHT )
+	{
+		if constexpr ( RANGE_EVAL::CLOSED_RIGHT )
+			tMask = _mm256_andnot_si256 ( _mm256_cmpgt_epi64 ( tValues, tMax ), tMask );
+		else
+			tMask = _mm256_and_si256 ( tMask, _mm256_cmpgt_epi64 ( tMax, tValues ) );
+	}
+
+	return tMask;
+}
+
+
+template <typename RANGE_EVAL, typename VALUES, typename T>
+FORCE_INLINE size_t FilterRange_SIMD ( const T * pValues, size_t tNumValues, VALUES tMin, VALUES tMax, uint32_t tRowID, uint32_t * & pRowID )
+{
+	const uint32_t * pPermutations = GetCompactPermutations();
+	__m256i tRowIDs = _mm256_add_epi32 ( _mm256_set1_epi32 ( (int)tRowID ), _mm256_setr_epi32 ( 0, 1, 2, 3, 4, 5, 6, 7 ) );
+
+	size_t i = 0;
+	if constexpr ( sizeof(T)==sizeof(uint32_t) && ( std::is_same_v<VALUES,uint32_t> || std::is_same_v<VALUES,float> ) )
+	{
+		const __m256i tStep = _mm256_set1_epi32(8);
+		for ( ; i+8<=tNumValues; i+=8 )
+		{
+			__m256i tValues = _mm256_loadu_si256 ( (const __m256i*)(pValues+i) );
+			int iMask;
+			if constexpr ( std::is_same_v<VALUES,float> )
+				iMask = _mm256_movemask_ps ( RangeMaskFloat_AVX2<RANGE_EVAL> ( _mm256_castsi256_ps(tValues), _mm256_set1_ps(tMin), _mm256_set1_ps(tMax) ) );
+			else
+				iMask = _mm256_movemask_ps ( _mm256_castsi256_ps ( RangeMask32_AVX2<RANGE_EVAL> ( tValues, _mm256_set1_epi32 ( (int)tMin ), _mm256_set1_epi32 ( (int)tMax ) ) ) );
+
+			__m256i tPermutation = _mm256_loadu_si256 ( (const __m256i*)( pPermutations + iMask*8 ) );
+			_mm256_storeu_si256 ( (__m256i*)pRowID, _mm256_permutevar8x32_epi32 ( tRowIDs, tPermutation ) );
+			pRowID += _mm_popcnt_u32(iMask);
+			tRowIDs = _mm256_add_epi32 ( tRowIDs, tStep );
+		}
+	}
+	else if constexpr ( sizeof(T)==sizeof(uint64_t) && ( std::is_same_v<VALUES,int64_t> || std::is_same_v<VALUES,uint64_t> ) )
+	{
+		const __m256i tStep = _mm256_set1_epi32(4);
+		const __m256i tFlip = _mm256_set1_epi64x ( std::is_signed_v<VALUES> ? 0 : (long long)0x8000000000000000ULL );
+		const __m256i tMinV = _mm256_xor_si256 ( _mm256_set1_epi64x ( (long long)tMin ), tFlip );
+		const __m256i tMaxV = _mm256_xor_si256 ( _mm256_set1_epi64x ( (long long)tMax ), tFlip );
+		for ( ; i+4<=tNumValues; i+=4 )
+		{
+			__m256i tValues = _mm256_xor_si256 ( _mm256_loadu_si256 ( (const __m256i*)(pValues+i) ), tFlip );
+			int iMask = _mm256_movemask_pd ( _mm256_castsi256_pd ( RangeMask64_AVX2<RANGE_EVAL> ( tValues, tMinV, tMaxV ) ) );
+
+			__m256i tPermutation = _mm256_loadu_si256 ( (const __m256i*)( pPermutations + iMask*8 ) );
+			_mm_storeu_si128 ( (__m128i*)pRowID, _mm256_castsi256_si128 ( _mm256_permutevar8x32_epi32 ( tRowIDs, tPermutation ) ) );
+			pRowID += _mm_popcnt_u32(iMask);
+			tRowIDs = _mm256_add_epi32 ( tRowIDs, tStep );
+		}
+	}
+
+	return i;
+}
+#else
+template <typename RANGE_EVAL, typename VALUES, typename T>
+FORCE_INLINE size_t FilterRange_SIMD ( const T *, size_t, VALUES, VALUES, uint32_t, uint32_t * & )
+{
+	return 0;
+}
+#endif
+
+
+// typed fetch that has no meaning for the attribute; the caller's buffer is still written
+template <typename T>
+FORCE_INLINE void FillZeroes ( util::Span_T<T> & dValues )
+{
+	std::fill ( dValues.begin(), dValues.end(), T(0) );
+}
+
+
+FORCE_INLINE void SetScanValues ( ScanSpan_t & tSpan, const util::Span_T<const uint32_t> & dValues, int iStart, int iEnd )
+{
+	tSpan.m_ePacking = ScanPacking_e::VALUES;
+	tSpan.m_dValues32 = { dValues.data()+iStart, size_t(iEnd-iStart) };
+}
+
+
+FORCE_INLINE void SetScanValues ( ScanSpan_t & tSpan, const util::Span_T<const uint64_t> & dValues, int iStart, int iEnd )
+{
+	tSpan.m_ePacking = ScanPacking_e::VALUES;
+	tSpan.m_dValues64 = { dValues.data()+iStart, size_t(iEnd-iStart) };
+}
+
+
+// codecs chosen per subblock by the builder (storage v18+); older storages use the configured codec everywhere
+class SubblockCodecs_c
+{
+public:
+	SubblockCodecs_c ( const std::string & sCodec32, const std::string & sCodec64, uint32_t uVersion )
+		: m_sCodec32 ( sCodec32 )
+		, m_sCodec64 ( sCodec64 )
+		, m_uVersion ( uVersion )
+		, m_pDefault ( util::CreateIntCodec ( sCodec32, sCodec64 ) )
+	{}
+
+	template <typename RD>
+	FORCE_INLINE void ReadHeader ( RD & tReader, int iNumSubblocks )
+	{
+		m_dCodecs.resize(iNumSubblocks);
+		if ( m_uVersion>=18 )
+			tReader.Read ( m_dCodecs.data(), iNumSubblocks );
+		else
+			memset ( m_dCodecs.data(), 0, iNumSubblocks );
+	}
+
+	FORCE_INLINE util::IntCodec_c & Get ( int iSubblockId )
+	{
+		if ( !m_dCodecs[iSubblockId] )
+			return *m_pDefault;
+
+		// most subblocks stay with the default codec, so the alternative one is created on demand
+		if ( !m_pAlt )
+			m_pAlt = util::CreateIntCodec ( util::GetAltIntCodecName(m_sCodec32), util::GetAltIntCodecName(m_sCodec64) );
+
+		return *m_pAlt;
+	}
+
+private:
+	std::string					m_sCodec32;
+	std::string					m_sCodec64;
+	uint32_t					m_uVersion = 0;
+	util::IntCodecPooledPtr_t	m_pDefault;
+	util::IntCodecPooledPtr_t	m_pAlt;
+	std::vector<uint8_t>		m_dCodecs;
+};
+
 template <typename T, typename RD>
 FORCE_INLINE void DecodeValues_Delta_PFOR ( util::SpanResizeable_T<T> & dValues, RD & tReader, util::IntCodec_c & tCodec, util::SpanResizeable_T<uint32_t> & dTmp, uint32_t uTotalSize, bool bReadFlag, uint32_t uVersion )
 {
@@ -332,6 +784,18 @@ FORCE_INLINE void DecodeValues_Delta_PFOR ( util::SpanResizeable_T<T> & dValues,
 	if ( bReadFlag )
 		uFlags = tReader.Read_uint8();
 
+	if ( uFlags==util::to_underlying ( IntDeltaPacking_e::DELTA_OF_DELTA ) )
+	{
+		T tFirst = (T)tReader.Unpack_uint64();
+		uint32_t uPFOREncodedSize = uint32_t ( uTotalSize - ( tReader.GetPos() - tStart ) );
+		assert ( uPFOREncodedSize % 4 == 0 );
+
+		util::Span_T<uint32_t> dSrc = util::ReadCompressedSpan ( tReader, dTmp, uPFOREncodedSize>>2, tCodec.CanDecodeUnaligned() );
+		tCodec.Decode ( dSrc, dValues );
+		ComputeInverseDeltasOfDeltas ( dValues, tFirst );
+		return;
+	}
+
 	bool bAsc = uFlags==util::to_underlying ( IntDeltaPacking_e::DELTA_ASC );
 
 	if ( uVersion >= 11 )
@@ -380,6 +844,130 @@ FORCE_INLINE void DecodeValues_PFOR ( util::SpanResizeable_T<T> & dValues, RD &
 	AddMinValue ( dValues, uMin );
 }
 
+// run ends of an RLE-packed block: exclusive in-block offsets, ascending
+class BlockRuns_c
+{
+public:
+	template <typename RD>
+	FORCE_INLINE void		Read ( RD & tReader, int iNumRuns, util::IntCodec_c & tCodec );
+
+	FORCE_INLINE int		GetNumRuns() const				{ return (int)m_dRunEnds.size(); }
+	FORCE_INLINE uint32_t	GetRunStart ( int iRun ) const	{ return iRun ? m_dRunEnds[iRun-1] : 0; }
+	FORCE_INLINE uint32_t	GetRunEnd ( int iRun ) const	{ return m_dRunEnds[iRun]; }
+	FORCE_INLINE int		FindRun ( uint32_t uIdInBlock );
+
+	// calls fnProcess ( iRun, uStart, uEnd ) for every run intersecting [uStartInBlock, uEndInBlock)
+	template <typename FN>
+	FORCE_INLINE void		ForEachRun ( uint32_t uStartInBlock, uint32_t uEndInBlock, FN && fnProcess );
+
+private:
+	util::SpanResizeable_T<uint32_t>	m_dRunEnds;
+	util::SpanResizeable_T<uint32_t>	m_dTmp;
+	int									m_iRun = 0;
+};
+
+template <typename RD>
+void BlockRuns_c::Read ( RD & tReader, int iNumRuns, util::IntCodec_c & tCodec )
+{
+	m_dRunEnds.resize(iNumRuns);
+	uint32_t uTotalSize = tReader.Unpack_uint32();
+	assert ( uTotalSize % 4 == 0 );
+
+	util::Span_T<uint32_t> dSrc = util::ReadCompressedSpan ( tReader, m_dTmp, uTotalSize>>2, tCodec.CanDecodeUnaligned() );
+	tCodec.DecodeDelta ( dSrc, m_dRunEnds );
+	m_iRun = 0;
+}
+
+int BlockRuns_c::FindRun ( uint32_t uIdInBlock )
+{
+	// rowids usually come sorted, so we start from the last run found
+	uint32_t * pStart = m_dRunEnds.data();
+	if ( uIdInBlock>=GetRunStart(m_iRun) )
+	{
+		if ( uIdInBlock<m_dRunEnds[m_iRun] )
+			return m_iRun;
+
+		pStart += m_iRun+1;
+	}
+
+	m_iRun = int ( std::upper_bound ( pStart, m_dRunEnds.end(), uIdInBlock ) - m_dRunEnds.data() );
+	assert ( m_iRun<GetNumRuns() );
+	return m_iRun;
+}
+
+template <typename FN>
+void BlockRuns_c::ForEachRun ( uint32_t uStartInBlock, uint32_t uEndInBlock, FN && fnProcess )
+{
+	if ( uStartInBlock>=uEndInBlock )
+		return;
+
+	for ( int iRun = FindRun(uStartInBlock); uStartInBlock < uEndInBlock; iRun++ )
+	{
+		uint32_t uRunEnd = std::min ( m_dRunEnds[iRun], uEndInBlock );
+		fnProcess ( iRun, uStartInBlock, uRunEnd );
+		uStartInBlock = uRunEnd;
+	}
+}
+
+// converts biased decimals written by the float packer back to float bit patterns
+// the result must match util::DecimalToFloat bit for bit, so the SSE path uses the same double multiply + round to float
+FORCE_INLINE void DecodeDecimalFloats ( util::Span_T<uint32_t> & dValues, int iExp )
+{
+	const uint32_t BIAS = 0x80000000;
+	uint32_t * pValue = dValues.data();
+	uint32_t * pEnd = dValues.end();
+
+	const __m128i tBias = _mm_set1_epi32 ( (int)BIAS );
+	const __m128d tScale = _mm_set1_pd ( util::GetFloatDecimalScale(iExp) );
+	for ( ; pValue+4 <= pEnd; pValue += 4 )
+	{
+		__m128i tDecimals = _mm_xor_si128 ( _mm_loadu_si128 ( (const __m128i*)pValue ), tBias );
+		__m128 tLo = _mm_cvtpd_ps ( _mm_mul_pd ( _mm_cvtepi32_pd(tDecimals), tScale ) );
+		__m128 tHi = _mm_cvtpd_ps ( _mm_mul_pd ( _mm_cvtepi32_pd ( _mm_srli_si128 ( tDecimals, 8 ) ), tScale ) );
+		_mm_storeu_ps ( (float*)pValue, _mm_movelh_ps ( tLo, tHi ) );
+	}
+
+	for ( ; pValue < pEnd; pValue++ )
+		*pValue = util::FloatToUint ( util::DecimalToFloat ( int32_t ( *pValue ^ BIAS ), iExp ) );
+}
+
+template <typename T, typename RD>
+FORCE_INLINE void DecodeValues_Float ( util::SpanResizeable_T<T> & dValues, RD & tReader, util::IntCodec_c & tCodec, util::SpanResizeable_T<uint32_t> & dTmp, uint32_t uTotalSize )
+{
+	if constexpr ( std::is_same_v<T,uint32_t> )
+	{
+		int64_t tStart = tReader.GetPos();
+		auto ePacking = (FloatPacking_e)tReader.Read_uint8();
+		int iExp = ePacking==FloatPacking_e::DECIMAL ? tReader.Read_uint8() : 0;
+		DecodeValues_PFOR ( dValues, tReader, tCodec, dTmp, uint32_t ( uTotalSize - ( tReader.GetPos() - tStart ) ) );
+
+		if ( ePacking==FloatPacking_e::DECIMAL )
+			DecodeDecimalFloats ( dValues, iExp );
+		else
+			ComputeInverseXorDeltas ( dValues );
+	}
+	else
+		assert ( 0 && "INTERNAL ERROR: float packing of a 64-bit attribute" );
+}
+
+template <typename T>
+FORCE_INLINE void AppendBlobValue ( const util::Span_T<T> & dValue, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets )
+{
+	const uint8_t * pData = (const uint8_t *)dValue.data();
+	dBlob.insert ( dBlob.end(), pData, pData + dValue.size()*sizeof(T) );
+	dOffsets.push_back ( (int64_t)dBlob.size() );
+}
+
+// same layout as ByteCodec_c::PackData, but the memory comes from the arena
+FORCE_INLINE uint8_t * PackValue ( const uint8_t * pData, size_t tLength, PackedArena_i & tArena )
+{
+	uint8_t * pResult = tArena.Allocate ( util::ByteCodec_c::CalcPackedLen(tLength) + tLength );
+	uint8_t * pValue = pResult;
+	util::ByteCodec_c::Pack_uint64 ( pValue, tLength );
+	memcpy ( pValue, pData, tLength );
+	return pResult;
+}
+
 template <typename T, bool PACK>
 FORCE_INLINE uint32_t PackValue ( const util::Span_T<T> & dValue, uint8_t * & pValue )
 {
@@ -16,6 +16,8 @@
 
 #include "attributeheader.h"
 #include "buildertraits.h"
+#include "builderbloom.h"
+#include "builderstr.h"
 #include "reader.h"
 #include "check.h"
 
@@ -35,6 +37,7 @@ public:
 	inline int			GetNumLevels() const					{ return (int)m_dTreeLevels.size(); }
 	inline int			GetNumBlocks ( int iLevel ) const		{ return m_dTreeLevels[iLevel].first; }
 	inline Element_t	Get ( int iLevel, int iBlock ) const	{ return m_dTreeLevels[iLevel].second[iBlock]; }
+	inline int64_t		GetMemory() const						{ return int64_t ( m_dMinMaxTree.size()*sizeof(Element_t) + m_dTreeLevels.size()*sizeof(TreeLevel_t) ); }
 
 	bool				Load ( FileReader_c & tReader, std::string & sError );
 	bool				Check ( FileReader_c & tReader, Reporter_fn & fnError );
@@ -154,11 +157,91 @@ void MinMax_T<float>::LoadTreeLevels ( FileReader_c & tReader )
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+class BloomFilters_c
+{
+public:
+	bool		IsEmpty() const { return m_dNumBuckets.empty(); }
+	FORCE_INLINE bool MayContain ( int iBlock, uint64_t uValue ) const { return !m_dNumBuckets[iBlock] || BloomCheck ( m_dFilters.data() + m_dOffsets[iBlock], m_dNumBuckets[iBlock], uValue ); }
+	int64_t		GetMemory() const { return int64_t ( m_dNumBuckets.capacity()*sizeof(m_dNumBuckets[0]) + m_dOffsets.capacity()*sizeof(m_dOffsets[0]) + m_dFilters.capacity()*sizeof(m_dFilters[0]) ); }
+
+	bool		Load ( FileReader_c & tReader, std::string & sError );
+	bool		Check ( FileReader_c & tReader, int iMaxBlocks, Reporter_fn & fnError );
+
+private:
+	std::vector<uint32_t>	m_dNumBuckets;
+	std::vector<uint64_t>	m_dOffsets;
+	std::vector<uint32_t>	m_dFilters;
+};
+
+
+bool BloomFilters_c::Load ( FileReader_c & tReader, std::string & sError )
+{
+	bool bHaveBloom = !!tReader.Read_uint8();
+	if ( !bHaveBloom )
+		return !tReader.IsError();
+
+	m_dNumBuckets.resize ( tReader.Unpack_uint32() );
+	m_dOffsets.resize ( m_dNumBuckets.size() );
+
+	uint64_t uTotalWords = 0;
+	for ( size_t i = 0; i < m_dNumBuckets.size(); i++ )
+	{
+		m_dNumBuckets[i] = tReader.Unpack_uint32();
+		m_dOffsets[i] = uTotalWords;
+		uTotalWords += (uint64_t)m_dNumBuckets[i]*BLOOM_BUCKET_WORDS;
+	}
+
+	m_dFilters.resize(uTotalWords);
+	tReader.Read ( (uint8_t*)m_dFilters.data(), m_dFilters.size()*sizeof(m_dFilters[0]) );
+
+	if ( tReader.IsError() )
+	{
+		sError = tReader.GetError();
+		return false;
+	}
+
+	return true;
+}
+
+
+bool BloomFilters_c::Check ( FileReader_c & tReader, int iMaxBlocks, Reporter_fn & fnError )
+{
+	uint8_t uFlag = 0;
+	if ( !CheckUint8 ( tReader, 0, 1, "Bloom filters presence flag", uFlag, fnError ) )
+		return false;
+
+	if ( !uFlag )
+		return true;
+
+	int iNumFilters = 0;
+	if ( !CheckInt32Packed ( tReader, 0, iMaxBlocks, "Number of bloom filters", iNumFilters, fnError ) ) return false;
+
+	int64_t iTotalWords = 0;
+	for ( int i = 0; i < iNumFilters; i++ )
+	{
+		int iNumBuckets = 0;
+		if ( !CheckInt32Packed ( tReader, 0, DOCS_PER_BLOCK, "Number of bloom filter buckets", iNumBuckets, fnError ) ) return false;
+		iTotalWords += (int64_t)iNumBuckets*BLOOM_BUCKET_WORDS;
+	}
+
+	int64_t iEnd = tReader.GetPos() + iTotalWords*(int64_t)sizeof(uint32_t);
+	if ( iEnd > tReader.GetFileSize() )
+	{
+		fnError ( "Bloom filters out of bounds" );
+		return false;
+	}
+
+	tReader.Seek(iEnd);
+	return true;
+}
+
 //////////////////////////////////////////////////////////////////////////
 class AttributeHeader_c : public AttributeHeader_i, public Settings_t
 {
 public:
-							AttributeHeader_c ( AttrType_e eType, uint32_t uTotalDocs );
+							AttributeHeader_c ( AttrType_e eType, uint32_t uTotalDocs, uint32_t uVersion );
 
 	const std::string &		GetName() const override			{ return m_sName; }
 	AttrType_e				GetType() const override			{ return m_eType; }
@@ -174,10 +257,30 @@ public:
 	int						GetNumMinMaxBlocks ( int iLevel ) const override { return 0; }
 	std::pair<int64_t,int64_t> GetMinMax ( int iLevel, int iBlock ) const override { return {0, 0}; }
 
+	bool					HaveStrMinMax() const override		{ return false; }
+	std::pair<uint64_t,uint64_t> GetStrMinMax ( int iLevel, int iBlock ) const override { return { 0, UINT64_MAX }; }
+
+	bool					HaveBloomFilters() const override	{ return false; }
+	bool					BloomMayContain ( int iBlock, uint64_t uValue ) const override { return true; }
+
+	SortOrder_e				GetSortOrder() const override		{ return m_eSortOrder; }
+
+	int						GetNumDictValues() const override	{ return 0; }
+	Span_T<const uint8_t>	GetDictValue ( int iId ) const override { return {}; }
+
+	int64_t					GetHeaderMemory() const override;
+	int64_t					GetMinMaxMemory() const override	{ return 0; }
+	AttributeCounters_t &	GetCounters() const override		{ return m_tCounters; }
+
 	bool					Load ( FileReader_c & tReader, std::string & sError ) override;
 	bool					Check ( FileReader_c & tReader, Reporter_fn & fnError ) override;
 
+protected:
+	uint32_t				m_uVersion = 0;
+
 private:
+	mutable AttributeCounters_t m_tCounters;
+
 	std::string				m_sName;
 	AttrType_e				m_eType = AttrType_e::NONE;
 	float					m_fComplexity = 0.0f;
@@ -186,14 +289,16 @@ private:
 
 	std::vector<uint64_t>	m_dBlocks;
 	std::vector<uint32_t>	m_dPackings;
+	SortOrder_e				m_eSortOrder = SortOrder_e::NONE;
 
 	float					CalcComplexity() const;
 	float					CalcIntComplexity() const;
 };
 
 
-AttributeHeader_c::AttributeHeader_c ( AttrType_e eType, uint32_t uTotalDocs )
-	: m_eType ( eType )
+AttributeHeader_c::AttributeHeader_c ( AttrType_e eType, uint32_t uTotalDocs, uint32_t uVersion )
+	: m_uVersion ( uVersion )
+	, m_eType ( eType )
 	, m_uTotalDocs ( uTotalDocs )
 {}
 
@@ -210,6 +315,12 @@ uint32_t AttributeHeader_c::GetNumDocs ( int iBlock ) const
 }
 
 
+int64_t AttributeHeader_c::GetHeaderMemory() const
+{
+	return int64_t ( sizeof(*this) + m_sName.capacity() + m_dBlocks.capacity()*sizeof(m_dBlocks[0]) + m_dPackings.capacity()*sizeof(m_dPackings[0]) );
+}
+
+
 bool AttributeHeader_c::Load ( FileReader_c & tReader, std::string & sError )
 {
 	m_tSettings.Load(tReader);
@@ -229,6 +340,9 @@ bool AttributeHeader_c::Load ( FileReader_c & tReader, std::string & sError )
 	for ( auto & i : m_dPackings )
 		i = tReader.Unpack_uint32();
 
+	if ( m_uVersion>=21 )
+		m_eSortOrder = (SortOrder_e)tReader.Read_uint8();
+
 	m_fComplexity = CalcComplexity();
 
 	if ( tReader.IsError() )
@@ -267,6 +381,9 @@ bool AttributeHeader_c::Check ( FileReader_c & tReader, Reporter_fn & fnError )
 	for ( int i = 0; i < iNumPackings; i++ )
 		if ( !CheckInt32Packed ( tReader, 0, iBlocks, "Packing stats", iPacking, fnError ) ) return false;
 
+	uint8_t uSortOrder = 0;
+	if ( m_uVersion>=21 && !CheckUint8 ( tReader, 0, to_underlying(SortOrder_e::DESC), "Sort order", uSortOrder, fnError ) ) return false;
+
 	return true;
 }
 
@@ -279,7 +396,9 @@ float AttributeHeader_c::CalcIntComplexity() const
 		0.4f,	// TABLE
 		1.0f,	// DELTA
 		1.0f,	// GENERIC
-		1.0f	// HASH
+		1.0f,	// HASH
+		1.0f,	// FLOAT
+		0.2f	// RLE
 	};
 
 	uint32_t uTotal = 0;
@@ -323,11 +442,18 @@ public:
 	int				GetNumMinMaxBlocks ( int iLevel ) const override	{ return m_tMinMax.GetNumBlocks(iLevel); }
 	std::pair<int64_t,int64_t> GetMinMax ( int iLevel, int iBlock ) const override;
 
+	bool			HaveBloomFilters() const override	{ return !m_tBloom.IsEmpty(); }
+	bool			BloomMayContain ( int iBlock, uint64_t uValue ) const override { return m_tBloom.IsEmpty() || m_tBloom.MayContain ( iBlock, uValue ); }
+
+	int64_t			GetHeaderMemory() const override	{ return BASE::GetHeaderMemory() + m_tBloom.GetMemory(); }
+	int64_t			GetMinMaxMemory() const override	{ return m_tMinMax.GetMemory(); }
+
 	bool			Load ( FileReader_c & tReader, std::string & sError ) override;
 	bool			Check ( FileReader_c & tReader, Reporter_fn & fnError ) override;
 
 private:
 	MinMax_T<T>		m_tMinMax;
+	BloomFilters_c	m_tBloom;
 };
 
 template <typename T>
@@ -337,8 +463,11 @@ bool AttributeHeader_Int_T<T>::Load ( FileReader_c & tReader, std::string & sErr
 		return false;
 
 	bool bHaveMinMax = !!tReader.Read_uint8();
-	if ( bHaveMinMax )
-		return m_tMinMax.Load ( tReader, sError );
+	if ( bHaveMinMax && !m_tMinMax.Load ( tReader, sError ) )
+		return false;
+
+	if ( m_uVersion>=14 )
+		return m_tBloom.Load ( tReader, sError );
 
 	return !tReader.IsError();
 }
@@ -353,8 +482,11 @@ bool AttributeHeader_Int_T<T>::Check ( FileReader_c & tReader, Reporter_fn & fnE
 	if ( !CheckUint8 ( tReader, 0, 1, "Minmax presence flag", uFlag, fnError ) )
 		return false;
 
-	if ( uFlag )
-		return m_tMinMax.Check ( tReader, fnError );
+	if ( uFlag && !m_tMinMax.Check ( tReader, fnError ) )
+		return false;
+
+	if ( m_uVersion>=14 )
+		return m_tBloom.Check ( tReader, int ( BASE::GetNumDocs()/DOCS_PER_BLOCK )+1, fnError );
 
 	return true;
 }
@@ -375,35 +507,140 @@ std::pair<int64_t,int64_t> AttributeHeader_Int_T<float>::GetMinMax ( int iLevel,
 
 //////////////////////////////////////////////////////////////////////////
 
-AttributeHeader_i * CreateAttributeHeader ( AttrType_e eType, uint32_t uTotalDocs, std::string & sError )
+// string length minmax + truncated prefix minmax
+class AttributeHeader_String_c : public AttributeHeader_Int_T<uint32_t>
+{
+	using BASE = AttributeHeader_Int_T<uint32_t>;
+	using BASE::AttributeHeader_Int_T;
+
+public:
+	bool			HaveStrMinMax() const override { return m_bHavePrefixMinMax; }
+	std::pair<uint64_t,uint64_t> GetStrMinMax ( int iLevel, int iBlock ) const override { return m_tPrefixMinMax.Get ( iLevel, iBlock ); }
+	int64_t			GetMinMaxMemory() const override	{ return BASE::GetMinMaxMemory() + m_tPrefixMinMax.GetMemory(); }
+	int64_t			GetHeaderMemory() const override;
+
+	int				GetNumDictValues() const override	{ return m_dDictOffsets.empty() ? 0 : int ( m_dDictOffsets.size()-1 ); }
+	Span_T<const uint8_t> GetDictValue ( int iId ) const override { return { m_dDictValues.data()+m_dDictOffsets[iId], size_t ( m_dDictOffsets[iId+1]-m_dDictOffsets[iId] ) }; }
+
+	bool			Load ( FileReader_c & tReader, std::string & sError ) override;
+	bool			Check ( FileReader_c & tReader, Reporter_fn & fnError ) override;
+
+private:
+	MinMax_T<uint64_t>	m_tPrefixMinMax;
+	bool			m_bHavePrefixMinMax = false;
+
+	std::vector<uint8_t>	m_dDictValues;
+	std::vector<uint32_t>	m_dDictOffsets;
+};
+
+
+int64_t AttributeHeader_String_c::GetHeaderMemory() const
+{
+	return BASE::GetHeaderMemory() + int64_t ( m_dDictValues.capacity()*sizeof(m_dDictValues[0]) + m_dDictOffsets.capacity()*sizeof(m_dDictOffsets[0]) );
+}
+
+
+bool AttributeHeader_String_c::Load ( FileReader_c & tReader, std::string & sError )
+{
+	if ( !BASE::Load ( tReader, sError ) )
+		return false;
+
+	if ( m_uVersion<15 )
+		return true;
+
+	m_bHavePrefixMinMax = !!tReader.Read_uint8();
+	if ( m_bHavePrefixMinMax && !m_tPrefixMinMax.Load ( tReader, sError ) )
+		return false;
+
+	// both trees are built over the same subblocks
+	m_bHavePrefixMinMax &= m_tPrefixMinMax.GetNumLevels()==GetNumMinMaxLevels();
+
+	if ( m_uVersion>=19 )
+	{
+		uint32_t uNumValues = tReader.Unpack_uint32();
+		m_dDictOffsets.resize ( uNumValues ? uNumValues+1 : 0 );
+		m_dDictValues.resize(0);
+		for ( uint32_t i = 0; i < uNumValues && !tReader.IsError(); i++ )
+		{
+			uint32_t uLength = tReader.Unpack_uint32();
+			m_dDictOffsets[i] = (uint32_t)m_dDictValues.size();
+			m_dDictValues.resize ( m_dDictValues.size()+uLength );
+			tReader.Read ( m_dDictValues.data()+m_dDictOffsets[i], uLength );
+		}
+
+		if ( uNumValues )
+			m_dDictOffsets[uNumValues] = (uint32_t)m_dDictValues.size();
+	}
+
+	return !tReader.IsError();
+}
+
+
+bool AttributeHeader_String_c::Check ( FileReader_c & tReader, Reporter_fn & fnError )
+{
+	if ( !BASE::Check ( tReader, fnError ) )
+		return false;
+
+	if ( m_uVersion<15 )
+		return true;
+
+	uint8_t uFlag = 0;
+	if ( !CheckUint8 ( tReader, 0, 1, "Prefix minmax presence flag", uFlag, fnError ) )
+		return false;
+
+	if ( uFlag && !m_tPrefixMinMax.Check ( tReader, fnError ) )
+		return false;
+
+	if ( m_uVersion<19 )
+		return true;
+
+	int iNumValues = 0;
+	if ( !CheckInt32Packed ( tReader, 0, MAX_GLOBAL_DICT_VALUES, "Number of dictionary values", iNumValues, fnError ) )
+		return false;
+
+	for ( int i = 0; i < iNumValues; i++ )
+	{
+		int iLength = 0;
+		if ( !CheckInt32Packed ( tReader, 0, MAX_GLOBAL_DICT_BYTES, "Dictionary value length", iLength, fnError ) )
+			return false;
+
+		tReader.Seek ( tReader.GetPos()+iLength );
+	}
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+AttributeHeader_i * CreateAttributeHeader ( AttrType_e eType, uint32_t uTotalDocs, uint32_t uVersion, std::string & sError )
 {
 	switch ( eType )
 	{
 	case AttrType_e::UINT32:
 	case AttrType_e::TIMESTAMP:
-		return new AttributeHeader_Int_T<uint32_t> ( eType, uTotalDocs );
+		return new AttributeHeader_Int_T<uint32_t> ( eType, uTotalDocs, uVersion );
 
 	case AttrType_e::INT64:
-		return new AttributeHeader_Int_T<int64_t> ( eType, uTotalDocs );
+		return new AttributeHeader_Int_T<int64_t> ( eType, uTotalDocs, uVersion );
 
 	case AttrType_e::UINT64:
-		return new AttributeHeader_Int_T<uint64_t> ( eType, uTotalDocs );
+		return new AttributeHeader_Int_T<uint64_t> ( eType, uTotalDocs, uVersion );
 
 	case AttrType_e::BOOLEAN:
-		return new AttributeHeader_Int_T<uint8_t> ( eType, uTotalDocs );
+		return new AttributeHeader_Int_T<uint8_t> ( eType, uTotalDocs, uVersion );
 
 	case AttrType_e::FLOAT:
 	case AttrType_e::FLOATVEC:
-		return new AttributeHeader_Int_T<float> ( eType, uTotalDocs );
+		return new AttributeHeader_Int_T<float> ( eType, uTotalDocs, uVersion );
 
 	case AttrType_e::STRING:
-		return new AttributeHeader_Int_T<uint32_t> (eType, uTotalDocs);
+		return new AttributeHeader_String_c ( eType, uTotalDocs, uVersion );
 
 	case AttrType_e::UINT32SET:
-		return new AttributeHeader_Int_T<uint32_t> ( eType, uTotalDocs );
+		return new AttributeHeader_Int_T<uint32_t> ( eType, uTotalDocs, uVersion );
 
 	case AttrType_e::INT64SET:
-		return new AttributeHeader_Int_T<int64_t> ( eType, uTotalDocs );
+		return new AttributeHeader_Int_T<int64_t> ( eType, uTotalDocs, uVersion );
 
 	default:
 		sError = "unknown data type";
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "columnar.h"
+#include <atomic>
 
 namespace util
 {
@@ -27,6 +28,15 @@ namespace columnar
 {
 
 struct Settings_t;
+enum class SortOrder_e : uint8_t;
+
+// updated by the accessors; shared by all readers of the attribute
+struct AttributeCounters_t
+{
+	std::atomic<int64_t>	m_iBlocksDecoded {0};
+	std::atomic<int64_t>	m_iSubblocksSkipped {0};
+	std::atomic<int64_t>	m_iBytesRead {0};
+};
 
 class AttributeHeader_i
 {
@@ -47,11 +57,26 @@ public:
 	virtual int					GetNumMinMaxBlocks ( int iLevel ) const = 0;
 	virtual std::pair<int64_t,int64_t> GetMinMax ( int iLevel, int iBlock ) const = 0;
 
+	virtual bool				HaveStrMinMax() const = 0;
+	virtual std::pair<uint64_t,uint64_t> GetStrMinMax ( int iLevel, int iBlock ) const = 0;	// string prefix keys (see StringPrefixKey); same tree shape as GetMinMax
+
+	virtual bool				HaveBloomFilters() const = 0;
+	virtual bool				BloomMayContain ( int iBlock, uint64_t uValue ) const = 0;	// false means that the block definitely has no such value
+
+	virtual SortOrder_e			GetSortOrder() const = 0;		// NONE unless the values are monotonic in rowid order
+
+	virtual int					GetNumDictValues() const = 0;	// file-level string dictionary referenced by global-packed blocks
+	virtual util::Span_T<const uint8_t> GetDictValue ( int iId ) const = 0;
+
+	virtual int64_t				GetHeaderMemory() const = 0;	// block offsets, packings, bloom filters and the string dictionary
+	virtual int64_t				GetMinMaxMemory() const = 0;
+	virtual AttributeCounters_t & GetCounters() const = 0;
+
 	virtual bool				Load ( util::FileReader_c & tReader, std::string & sError ) = 0;
 	virtual bool				Check ( util::FileReader_c & tReader, Reporter_fn & fnError ) = 0;
 };
 
 
-AttributeHeader_i * CreateAttributeHeader ( common::AttrType_e eType, uint32_t uTotalDocs, std::string & sError );
+AttributeHeader_i * CreateAttributeHeader ( common::AttrType_e eType, uint32_t uTotalDocs, uint32_t uVersion, std::string & sError );
 
 } // namespace columnar
@@ -74,12 +74,15 @@ public:
 private:
 	const std::string & m_sFilename;
 	uint32_t			m_uTotalDocs = 0;
+	uint32_t			m_uVersion = 0;
 	Reporter_fn &		m_fnError;
 	Reporter_fn &		m_fnProgress;
 	FileReader_c		m_tReader;
 	std::vector<std::unique_ptr<AttributeHeader_i>>	m_dHeaders;
+	std::vector<int64_t>	m_dHeaderOffsets;
 
 	bool				CheckHeaders ( int iNumAttrs );
+	bool				CheckDirectory ( int64_t iDirOffset );
 	Checker_i *			CreateChecker ( const AttributeHeader_i & tHeader ) const;
 };
 
@@ -101,17 +104,26 @@ bool StorageChecker_c::Check()
 		return false;
 	}
 
-	uint32_t uStorageVersion = m_tReader.Read_uint32();
-	if ( StorageVersionWrong ( uStorageVersion ) )
+	m_uVersion = m_tReader.Read_uint32();
+	if ( StorageVersionWrong ( m_uVersion ) )
 	{
-		m_fnError ( FormatStr ( "Unable to load columnar storage: %s is v.%d, binary is v.%d", m_sFilename.c_str(), uStorageVersion, STORAGE_VERSION ).c_str() );
+		m_fnError ( FormatStr ( "Unable to load columnar storage: %s is v.%d, binary is v.%d", m_sFilename.c_str(), m_uVersion, STORAGE_VERSION ).c_str() );
 		return false;
 	}
 
 	int iNumAttrs = (int)m_tReader.Read_uint32();
+
+	// the directory duplicates header offsets; headers are checked sequentially, then matched against the directory
+	int64_t iDirOffset = 0;
+	if ( m_uVersion>=16 && !CheckInt64 ( m_tReader, 0, m_tReader.GetFileSize(), "Attribute directory offset", iDirOffset, m_fnError ) )
+		return false;
+
 	if ( iNumAttrs && !CheckHeaders(iNumAttrs) )
 		return false;
 
+	if ( iNumAttrs && m_uVersion>=16 && !CheckDirectory(iDirOffset) )
+		return false;
+
 	// headers are ok and loaded, time to run checks
 	for ( const auto & i : m_dHeaders )
 	{
@@ -168,10 +180,12 @@ Checker_i * StorageChecker_c::CreateChecker ( const AttributeHeader_i & tHeader
 bool StorageChecker_c::CheckHeaders ( int iNumAttrs )
 {
 	m_dHeaders.resize(iNumAttrs);
+	m_dHeaderOffsets.resize(iNumAttrs);
 	int64_t iFileSize = m_tReader.GetFileSize();
 
 	for ( size_t i = 0; i < m_dHeaders.size(); i++ )
 	{
+		m_dHeaderOffsets[i] = m_tReader.GetPos();
 		AttrType_e eType = AttrType_e ( m_tReader.Read_uint32() );
 		if ( eType>=AttrType_e::TOTAL )
 		{
@@ -180,7 +194,7 @@ bool StorageChecker_c::CheckHeaders ( int iNumAttrs )
 		}
 
 		std::string sError;
-		std::unique_ptr<AttributeHeader_i> pHeader ( CreateAttributeHeader ( eType, m_uTotalDocs, sError ) );
+		std::unique_ptr<AttributeHeader_i> pHeader ( CreateAttributeHeader ( eType, m_uTotalDocs, m_uVersion, sError ) );
 		if ( !pHeader )
 		{
 			m_fnError ( sError.c_str() );
@@ -215,6 +229,95 @@ bool StorageChecker_c::CheckHeaders ( int iNumAttrs )
 	return true;
 }
 
+
+bool StorageChecker_c::CheckDirectory ( int64_t iDirOffset )
+{
+	int64_t iFileSize = m_tReader.GetFileSize();
+	if ( iDirOffset<=m_dHeaderOffsets.back() )
+	{
+		m_fnError ( FormatStr ( "Attribute directory overlaps headers: %lld", iDirOffset ).c_str() );
+		return false;
+	}
+
+	m_tReader.Seek(iDirOffset);
+
+	if ( m_uVersion>=23 )
+	{
+		int iSubblockSize = 0;
+		if ( !CheckInt32 ( m_tReader, 128, 65536, "Subblock size", iSubblockSize, m_fnError ) )
+			return false;
+
+		if ( iSubblockSize!=m_dHeaders[0]->GetSettings().m_iSubblockSize )
+		{
+			m_fnError ( FormatStr ( "Subblock size mismatch: directory %d, header %d", iSubblockSize, m_dHeaders[0]->GetSettings().m_iSubblockSize ).c_str() );
+			return false;
+		}
+	}
+
+	std::vector<int64_t> dBodyOffsets ( m_dHeaders.size() );
+	for ( size_t i = 0; i < m_dHeaders.size(); i++ )
+	{
+		const AttributeHeader_i & tHeader = *m_dHeaders[i];
+
+		int64_t iNamePos = m_tReader.GetPos();
+		if ( !CheckString ( m_tReader, 0, 1024, "Attribute name", m_fnError ) )
+			return false;
+
+		m_tReader.Seek(iNamePos);
+		std::string sName = m_tReader.Read_string();
+		if ( sName!=tHeader.GetName() )
+		{
+			m_fnError ( FormatStr ( "Attribute name mismatch: directory '%s', header '%s'", sName.c_str(), tHeader.GetName().c_str() ).c_str() );
+			return false;
+		}
+
+		AttrType_e eType = AttrType_e ( m_tReader.Read_uint32() );
+		if ( eType!=tHeader.GetType() )
+		{
+			m_fnError ( FormatStr ( "Attribute type mismatch for '%s': directory %u, header %u", sName.c_str(), to_underlying(eType), to_underlying ( tHeader.GetType() ) ).c_str() );
+			return false;
+		}
+
+		int64_t iHeaderOffset = (int64_t)m_tReader.Read_uint64();
+		if ( iHeaderOffset!=m_dHeaderOffsets[i] )
+		{
+			m_fnError ( FormatStr ( "Header offset mismatch for '%s': directory %lld, actual %lld", sName.c_str(), iHeaderOffset, m_dHeaderOffsets[i] ).c_str() );
+			return false;
+		}
+
+		dBodyOffsets[i] = (int64_t)m_tReader.Read_uint64();
+	}
+
+	// bodies follow the directory back to back; each one must have a non-negative length and end before EOF
+	int64_t iPrevBody = m_tReader.GetPos();
+	for ( size_t i = 0; i < m_dHeaders.size(); i++ )
+	{
+		int64_t iBodyOffset = dBodyOffsets[i];
+		if ( iBodyOffset<iPrevBody || iBodyOffset>iFileSize )
+		{
+			m_fnError ( FormatStr ( "Body offset of '%s' out of bounds: %lld; expected [%lld,%lld]", m_dHeaders[i]->GetName().c_str(), iBodyOffset, iPrevBody, iFileSize ).c_str() );
+			return false;
+		}
+
+		const AttributeHeader_i & tHeader = *m_dHeaders[i];
+		if ( tHeader.GetNumBlocks() && (int64_t)tHeader.GetBlockOffset(0)!=iBodyOffset )
+		{
+			m_fnError ( FormatStr ( "Body offset mismatch for '%s': directory %lld, header %lld", tHeader.GetName().c_str(), iBodyOffset, (int64_t)tHeader.GetBlockOffset(0) ).c_str() );
+			return false;
+		}
+
+		iPrevBody = iBodyOffset;
+	}
+
+	if ( m_tReader.IsError() )
+	{
+		m_fnError ( m_tReader.GetError().c_str() );
+		return false;
+	}
+
+	return true;
+}
+
 /////////////////////////////////////////////////////////////////////
 
 bool CheckString ( FileReader_c & tReader, int iMinLength, int iMaxLength, const std::string & sMessage, Reporter_fn & fnError )
@@ -0,0 +1,128 @@
+// Copyright (c) 2020-2025, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subblockcache.h"
+#include "columnar.h"
+
+namespace columnar
+{
+
+SubblockCache_c::SubblockCache_c ( uint64_t uMaxSize )
+	: m_uMaxShardSize ( uMaxSize/NUM_SHARDS )
+	, m_pShards ( new Shard_t[NUM_SHARDS] )
+{}
+
+
+std::shared_ptr<const void> SubblockCache_c::GetEntry ( const Key_t & tKey )
+{
+	Shard_t & tShard = GetShard(tKey);
+	{
+		std::lock_guard<std::mutex> tLock ( tShard.m_tLock );
+		auto tFound = tShard.m_hEntries.find(tKey);
+		if ( tFound!=tShard.m_hEntries.end() )
+		{
+			Entry_t & tEntry = tShard.m_dEntries[tFound->second];
+			tEntry.m_bReferenced = true;
+			m_iHits.fetch_add ( 1, std::memory_order_relaxed );
+			return tEntry.m_pData;
+		}
+	}
+
+	m_iMisses.fetch_add ( 1, std::memory_order_relaxed );
+	return nullptr;
+}
+
+
+void SubblockCache_c::AddEntry ( const Key_t & tKey, std::shared_ptr<const void> pData, size_t tSize )
+{
+	Shard_t & tShard = GetShard(tKey);
+	std::lock_guard<std::mutex> tLock ( tShard.m_tLock );
+	if ( tShard.m_hEntries.count(tKey) )
+		return; // added by another accessor
+
+	Evict ( tShard, tSize );
+
+	int iEntry;
+	if ( tShard.m_dFree.empty() )
+	{
+		iEntry = (int)tShard.m_dEntries.size();
+		tShard.m_dEntries.emplace_back();
+	}
+	else
+	{
+		iEntry = tShard.m_dFree.back();
+		tShard.m_dFree.pop_back();
+	}
+
+	Entry_t & tEntry = tShard.m_dEntries[iEntry];
+	tEntry.m_tKey = tKey;
+	tEntry.m_pData = std::move(pData);
+	tEntry.m_tSize = tSize;
+	tEntry.m_bReferenced = false;
+
+	tShard.m_hEntries.insert ( { tKey, iEntry } );
+	tShard.m_uSize += tSize;
+}
+
+
+void SubblockCache_c::Evict ( Shard_t & tShard, size_t tSize )
+{
+	auto & dEntries = tShard.m_dEntries;
+	while ( tShard.m_uSize+tSize > m_uMaxShardSize && !tShard.m_hEntries.empty() )
+	{
+		if ( tShard.m_tHand>=dEntries.size() )
+			tShard.m_tHand = 0;
+
+		Entry_t & tEntry = dEntries[tShard.m_tHand++];
+		if ( !tEntry.m_pData )
+			continue;
+
+		// CLOCK: recently used entries get a second chance
+		if ( tEntry.m_bReferenced )
+		{
+			tEntry.m_bReferenced = false;
+			continue;
+		}
+
+		tShard.m_hEntries.erase ( tEntry.m_tKey );
+		tShard.m_uSize -= tEntry.m_tSize;
+		tShard.m_dFree.push_back ( int ( &tEntry - dEntries.data() ) );
+		tEntry.m_pData.reset();
+		tEntry.m_tSize = 0;
+		m_iEvictions.fetch_add ( 1, std::memory_order_relaxed );
+	}
+}
+
+
+void SubblockCache_c::GetStats ( SubblockCacheStats_t & tStats ) const
+{
+	tStats.m_iHits = m_iHits.load ( std::memory_order_relaxed );
+	tStats.m_iMisses = m_iMisses.load ( std::memory_order_relaxed );
+	tStats.m_iEvictions = m_iEvictions.load ( std::memory_order_relaxed );
+	tStats.m_iMaxSize = int64_t ( m_uMaxShardSize*NUM_SHARDS );
+	tStats.m_iSize = 0;
+	tStats.m_iEntries = 0;
+
+	for ( int i = 0; i < NUM_SHARDS; i++ )
+	{
+		Shard_t & tShard = m_pShards[i];
+		std::lock_guard<std::mutex> tLock ( tShard.m_tLock );
+		tStats.m_iSize += (int64_t)tShard.m_uSize;
+		tStats.m_iEntries += (int64_t)tShard.m_hEntries.size();
+	}
+}
+
+} // namespace columnar
@@ -0,0 +1,125 @@
+// Copyright (c) 2020-2025, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "util/util.h"
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+namespace columnar
+{
+
+struct SubblockCacheStats_t;
+
+// decoded subblocks shared by all accessors of a columnar storage; keyed by (attribute header, block, subblock)
+// memory-bounded with CLOCK eviction; entries are refcounted, so evicting a subblock doesn't affect accessors that still use it
+class SubblockCache_c
+{
+public:
+	explicit		SubblockCache_c ( uint64_t uMaxSize );
+
+	template <typename T>
+	std::shared_ptr<const std::vector<T>> Get ( const void * pAttr, uint32_t uBlockId, int iSubblockId );
+
+	template <typename T>
+	void			Add ( const void * pAttr, uint32_t uBlockId, int iSubblockId, const util::Span_T<T> & dValues );
+
+	void			GetStats ( SubblockCacheStats_t & tStats ) const;
+
+private:
+	static const int SHARD_BITS = 4;
+	static const int NUM_SHARDS = 1<<SHARD_BITS;
+
+	struct Key_t
+	{
+		const void *	m_pAttr = nullptr;
+		uint64_t		m_uSubblock = 0;
+
+		bool operator== ( const Key_t & tRhs ) const { return m_pAttr==tRhs.m_pAttr && m_uSubblock==tRhs.m_uSubblock; }
+	};
+
+	struct KeyHash_t
+	{
+		// std::hash is the identity for integers in libstdc++, so mix the key with a splitmix64 finalizer
+		static uint64_t	Mix ( const Key_t & tKey )
+		{
+			uint64_t uHash = uint64_t ( uintptr_t ( tKey.m_pAttr ) ) ^ ( tKey.m_uSubblock*0x9E3779B97F4A7C15ULL );
+			uHash = ( uHash ^ ( uHash >> 30 ) )*0xBF58476D1CE4E5B9ULL;
+			uHash = ( uHash ^ ( uHash >> 27 ) )*0x94D049BB133111EBULL;
+			return uHash ^ ( uHash >> 31 );
+		}
+
+		size_t operator() ( const Key_t & tKey ) const { return size_t ( Mix(tKey) ); }
+	};
+
+	struct Entry_t
+	{
+		Key_t					m_tKey;
+		std::shared_ptr<const void>	m_pData;
+		size_t					m_tSize = 0;
+		bool					m_bReferenced = false;
+	};
+
+	struct Shard_t
+	{
+		std::mutex				m_tLock;
+		std::unordered_map<Key_t,int,KeyHash_t> m_hEntries;
+		std::vector<Entry_t>	m_dEntries;
+		std::vector<int>		m_dFree;
+		size_t					m_tHand = 0;
+		uint64_t				m_uSize = 0;
+	};
+
+	uint64_t		m_uMaxShardSize = 0;
+	std::unique_ptr<Shard_t[]>	m_pShards;
+
+	std::atomic<int64_t>	m_iHits {0};
+	std::atomic<int64_t>	m_iMisses {0};
+	std::atomic<int64_t>	m_iEvictions {0};
+
+	static Key_t	MakeKey ( const void * pAttr, uint32_t uBlockId, int iSubblockId )	{ return { pAttr, ( uint64_t(uBlockId)<<32 ) | uint32_t(iSubblockId) }; }
+	Shard_t &		GetShard ( const Key_t & tKey ) const							{ return m_pShards [ KeyHash_t::Mix(tKey) >> ( 64-SHARD_BITS ) ]; }	// high bits; the low ones pick map buckets
+
+	std::shared_ptr<const void> GetEntry ( const Key_t & tKey );
+	void			AddEntry ( const Key_t & tKey, std::shared_ptr<const void> pData, size_t tSize );
+	void			Evict ( Shard_t & tShard, size_t tSize );
+};
+
+
+template <typename T>
+std::shared_ptr<const std::vector<T>> SubblockCache_c::Get ( const void * pAttr, uint32_t uBlockId, int iSubblockId )
+{
+	// all accessors of an attribute use the same value type, so the cast is safe
+	return std::static_pointer_cast<const std::vector<T>> ( GetEntry ( MakeKey ( pAttr, uBlockId, iSubblockId ) ) );
+}
+
+template <typename T>
+void SubblockCache_c::Add ( const void * pAttr, uint32_t uBlockId, int iSubblockId, const util::Span_T<T> & dValues )
+{
+	// rough per-entry overhead: vector, control block, map node
+	const size_t ENTRY_OVERHEAD = 128;
+	size_t tSize = dValues.size()*sizeof(T) + ENTRY_OVERHEAD;
+	if ( tSize>m_uMaxShardSize )
+		return;
+
+	auto pValues = std::make_shared<const std::vector<T>> ( dValues.begin(), dValues.end() );
+	AddEntry ( MakeKey ( pAttr, uBlockId, iSubblockId ), std::move(pValues), tSize );
+}
+
+} // namespace columnar
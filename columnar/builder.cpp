@@ -44,6 +44,8 @@ private:
 	std::string	m_sFile;
 	std::vector<std::vector<std::shared_ptr<Packer_i>>> m_dPackers;
 	std::vector<std::shared_ptr<Packer_i>> m_dFlatPackers;
+	std::vector<int64_t> m_dDirBodyOffsets;	// body offset stubs in the attribute directory
+	int			m_iSubblockSize = 0;
 
 	bool	WriteHeaders ( FileWriter_c & tWriter, std::string & sError );
 	bool	WriteBodies ( std::string & sError );
@@ -54,6 +56,7 @@ private:
 bool Builder_c::Setup ( const Settings_t & tSettings, const Schema_t & tSchema, const std::string & sFile, size_t tBufferSize, std::string & sError )
 {
 	m_sFile = sFile;
+	m_iSubblockSize = tSettings.m_iSubblockSize;
 
 	int iPackers = 0;
 
@@ -64,10 +67,13 @@ bool Builder_c::Setup ( const Settings_t & tSettings, const Schema_t & tSchema,
 		switch ( i.m_eType )
 		{
 		case AttrType_e::UINT32:
-		case AttrType_e::TIMESTAMP:
 			dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerUint32 ( tSettings, i.m_sName ) ) );
 			break;
 
+		case AttrType_e::TIMESTAMP:
+			dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerTimestamp ( tSettings, i.m_sName ) ) );
+			break;
+
 		case AttrType_e::INT64:
 			dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerInt64 ( tSettings, i.m_sName ) ) );
 			break;
@@ -157,9 +163,15 @@ bool Builder_c::WriteHeaders ( FileWriter_c & tWriter, std::string & sError )
 {
 	tWriter.Write_uint32 ( STORAGE_VERSION );
 	tWriter.Write_uint32 ( (uint32_t)m_dFlatPackers.size() );
+
+	int64_t tDirOffset = tWriter.GetPos();
+	tWriter.Write_uint64 ( 0 ); // stub
+
+	std::vector<int64_t> dHeaderOffsets;
 	for ( size_t i=0; i < m_dFlatPackers.size(); i++ )
 	{
 		auto & pPacker = m_dFlatPackers[i];
+		dHeaderOffsets.push_back ( tWriter.GetPos() );
 		if ( !pPacker->WriteHeader ( tWriter, sError ) )
 			return false;
 
@@ -167,6 +179,25 @@ bool Builder_c::WriteHeaders ( FileWriter_c & tWriter, std::string & sError )
 		tWriter.Write_uint64 ( tNextOffset + sizeof(int64_t) );
 	}
 
+	// attribute directory; lets the reader open the storage without loading the headers
+	tWriter.SeekAndWrite ( tDirOffset, tWriter.GetPos() );
+	tWriter.Write_uint32 ( m_iSubblockSize );
+	m_dDirBodyOffsets.resize(0);
+	for ( size_t i=0; i < m_dFlatPackers.size(); i++ )
+	{
+		tWriter.Write_string ( m_dFlatPackers[i]->GetName() );
+		tWriter.Write_uint32 ( to_underlying ( m_dFlatPackers[i]->GetType() ) );
+		tWriter.Write_uint64 ( dHeaderOffsets[i] );
+		m_dDirBodyOffsets.push_back ( tWriter.GetPos() );
+		tWriter.Write_uint64 ( 0 ); // stub
+	}
+
+	if ( tWriter.IsError() )
+	{
+		sError = tWriter.GetError();
+		return false;
+	}
+
 	return true;
 }
 
@@ -187,7 +218,7 @@ bool Builder_c::Done ( std::string & sError )
 {
 	std::for_each ( m_dFlatPackers.cbegin(), m_dFlatPackers.cend(), []( auto & i ){ i->Done(); } );
 
-	// [N][header0][offset_of_header1]...[body0]...
+	// [version][N][directory_offset][type0][header0][offset_of_header1]...[directory][body0]...
 
 	{
 		FileWriter_c tWriter;
@@ -198,10 +229,12 @@ bool Builder_c::Done ( std::string & sError )
 			return false;
 
 		int64_t tBodyOffset = tWriter.GetPos();
-		for ( auto & i : m_dFlatPackers )
+		for ( size_t i=0; i < m_dFlatPackers.size(); i++ )
 		{
-			i->CorrectOffset ( tWriter, tBodyOffset );
-			tBodyOffset += i->GetBodySize();
+			auto & pPacker = m_dFlatPackers[i];
+			pPacker->CorrectOffset ( tWriter, tBodyOffset );
+			tWriter.SeekAndWrite ( m_dDirBodyOffsets[i], tBodyOffset );
+			tBodyOffset += pPacker->GetBodySize();
 		}
 	}
 
@@ -220,13 +253,13 @@ bool CheckSubblockSize ( int iSubblockSize, std::string & sError )
 
 	if ( iSubblockSize < MIN_SUBBLOCK_SIZE )
 	{
-		FormatStr ( "Subblock sizes less than %d are not supported (%d specified)", MIN_SUBBLOCK_SIZE, iSubblockSize );
+		sError = FormatStr ( "Subblock sizes less than %d are not supported (%d specified)", MIN_SUBBLOCK_SIZE, iSubblockSize );
 		return false;
 	}
 
 	if ( iSubblockSize & ( MIN_SUBBLOCK_SIZE-1 ) )
 	{
-		FormatStr ( "Subblock size should be a multiple of %d (%d specified)", MIN_SUBBLOCK_SIZE, iSubblockSize );
+		sError = FormatStr ( "Subblock size should be a multiple of %d (%d specified)", MIN_SUBBLOCK_SIZE, iSubblockSize );
 		return false;
 	}
 
@@ -25,7 +25,7 @@
 namespace columnar
 {
 
-static const uint32_t STORAGE_VERSION = 13;
+static const uint32_t STORAGE_VERSION = 23;
 
 inline bool StorageVersionWrong ( uint32_t uVer ) noexcept
 {
@@ -35,6 +35,8 @@ inline bool StorageVersionWrong ( uint32_t uVer ) noexcept
 	return uVer > STORAGE_VERSION;
 }
 
+bool	CheckSubblockSize ( int iSubblockSize, std::string & sError );
+
 class Builder_i
 {
 public:
@@ -0,0 +1,124 @@
+// Copyright (c) 2020-2025, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "buildertraits.h"
+#include <algorithm>
+
+namespace columnar
+{
+
+// split-block bloom filter: a key sets one bit in each of the 8 words of a single 256-bit bucket
+static const int BLOOM_BUCKET_WORDS = 8;
+static const int BLOOM_BITS_PER_KEY = 8;
+static const uint32_t BLOOM_SALT[BLOOM_BUCKET_WORDS] = { 0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U };
+
+FORCE_INLINE uint64_t BloomHash ( uint64_t uKey )
+{
+	uKey ^= uKey >> 33;
+	uKey *= 0xff51afd7ed558ccdULL;
+	uKey ^= uKey >> 33;
+	uKey *= 0xc4ceb9fe1a85ec53ULL;
+	uKey ^= uKey >> 33;
+	return uKey;
+}
+
+FORCE_INLINE uint32_t * BloomBucket ( uint32_t * pFilter, uint32_t uNumBuckets, uint64_t uHash )
+{
+	return pFilter + ( ( ( uHash >> 32 ) * uNumBuckets ) >> 32 ) * BLOOM_BUCKET_WORDS;
+}
+
+FORCE_INLINE void BloomInsert ( uint32_t * pFilter, uint32_t uNumBuckets, uint64_t uKey )
+{
+	uint64_t uHash = BloomHash(uKey);
+	uint32_t * pBucket = BloomBucket ( pFilter, uNumBuckets, uHash );
+	for ( int i = 0; i < BLOOM_BUCKET_WORDS; i++ )
+		pBucket[i] |= 1U << ( ( uint32_t(uHash)*BLOOM_SALT[i] ) >> 27 );
+}
+
+FORCE_INLINE bool BloomCheck ( const uint32_t * pFilter, uint32_t uNumBuckets, uint64_t uKey )
+{
+	uint64_t uHash = BloomHash(uKey);
+	const uint32_t * pBucket = BloomBucket ( (uint32_t*)pFilter, uNumBuckets, uHash );
+	for ( int i = 0; i < BLOOM_BUCKET_WORDS; i++ )
+		if ( !( pBucket[i] & ( 1U << ( ( uint32_t(uHash)*BLOOM_SALT[i] ) >> 27 ) ) ) )
+			return false;
+
+	return true;
+}
+
+// collects values of a block and builds one filter per block; filters are sized by the number of unique values
+class BloomBuilder_c
+{
+public:
+	void		Add ( uint64_t uValue )	{ m_dCollected.push_back(uValue); }
+	void		Flush();
+	void		Skip();
+	bool		Save ( util::FileWriter_c & tWriter ) const;
+
+private:
+	std::vector<uint64_t>	m_dCollected;
+	std::vector<uint32_t>	m_dNumBuckets;
+	std::vector<uint32_t>	m_dFilters;
+};
+
+
+inline void BloomBuilder_c::Flush()
+{
+	std::sort ( m_dCollected.begin(), m_dCollected.end() );
+	auto tLast = std::unique ( m_dCollected.begin(), m_dCollected.end() );
+	size_t tNumKeys = tLast-m_dCollected.begin();
+
+	const int BUCKET_BITS = BLOOM_BUCKET_WORDS*32;
+	uint32_t uNumBuckets = uint32_t ( ( tNumKeys*BLOOM_BITS_PER_KEY + BUCKET_BITS - 1 ) / BUCKET_BITS );
+	uNumBuckets = std::max ( uNumBuckets, 1U );
+
+	size_t tStart = m_dFilters.size();
+	m_dFilters.resize ( tStart + uNumBuckets*BLOOM_BUCKET_WORDS, 0 );
+	for ( auto tIt = m_dCollected.begin(); tIt!=tLast; ++tIt )
+		BloomInsert ( &m_dFilters[tStart], uNumBuckets, *tIt );
+
+	m_dNumBuckets.push_back(uNumBuckets);
+	m_dCollected.resize(0);
+}
+
+// blocks without a filter are stored with 0 buckets and always pass
+inline void BloomBuilder_c::Skip()
+{
+	m_dNumBuckets.push_back(0);
+	m_dCollected.resize(0);
+}
+
+
+inline bool BloomBuilder_c::Save ( util::FileWriter_c & tWriter ) const
+{
+	if ( m_dFilters.empty() )
+	{
+		tWriter.Write_uint8(0);	// no block got a filter
+		return !tWriter.IsError();
+	}
+
+	tWriter.Write_uint8(1);	// bloom filters presence flag
+	tWriter.Pack_uint32 ( (uint32_t)m_dNumBuckets.size() );
+	for ( auto i : m_dNumBuckets )
+		tWriter.Pack_uint32(i);
+
+	tWriter.Write ( (const uint8_t*)m_dFilters.data(), m_dFilters.size()*sizeof(m_dFilters[0]) );
+	return !tWriter.IsError();
+}
+
+} // namespace columnar
@@ -49,7 +49,11 @@ bool AttributeHeaderBuilder_Bool_c::Save ( FileWriter_c & tWriter, int64_t & tBa
 		return false;
 
 	tWriter.Write_uint8(1); // minmax presence flag
-	return m_tMinMax.Save ( tWriter, sError );
+	if ( !m_tMinMax.Save ( tWriter, sError ) )
+		return false;
+
+	tWriter.Write_uint8(0); // bloom filters presence flag
+	return !tWriter.IsError();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -73,9 +77,15 @@ protected:
 	bool					m_bFirst = true;
 	bool					m_bConst = true;
 	bool					m_bConstValue = false;
+	bool					m_bPrevValue = false;
+	int						m_iRuns = 0;
 	std::vector<bool>		m_dCollected;
 	std::vector<uint32_t>	m_dValues;
 	std::vector<uint32_t>	m_dPacked;
+	IntCodecPooledPtr_t		m_pCodec;
+	std::vector<uint32_t>	m_dRunEnds;
+	std::vector<uint32_t>	m_dUncompressed;
+	std::vector<uint32_t>	m_dCompressed;
 
 
 	void				AnalyzeCollected ( int64_t tAttr );
@@ -84,6 +94,7 @@ protected:
 
 	void				WritePacked_Const();
 	void				WritePacked_Bitmap();
+	void				WritePacked_RLE();
 
 	void				WriteToFile ( BoolPacking_e ePacking );
 };
@@ -91,6 +102,7 @@ protected:
 
 Packer_Bool_c::Packer_Bool_c ( const Settings_t & tSettings, const std::string & sName )
 	: BASE ( tSettings, sName, AttrType_e::BOOLEAN )
+	, m_pCodec ( CreateIntCodec ( tSettings.m_sCompressionUINT32, tSettings.m_sCompressionUINT64 ) )
 {
 	assert ( !( tSettings.m_iSubblockSize & 127 ) );
 	m_dValues.resize ( tSettings.m_iSubblockSize );
@@ -128,11 +140,16 @@ void Packer_Bool_c::AnalyzeCollected ( int64_t tAttr )
 	{
 		m_bConstValue = bValue;
 		m_bFirst = false;
+		m_iRuns++;
 	}
+	else if ( m_bPrevValue!=bValue )
+		m_iRuns++;
 
 	if ( m_bConstValue!=bValue )
 		m_bConst = false;
 
+	m_bPrevValue = bValue;
+
 	m_tHeader.m_tMinMax.Add ( bValue ? 1 : 0 );
 }
 
@@ -142,6 +159,9 @@ BoolPacking_e Packer_Bool_c::ChoosePacking() const
 	if ( m_bConst )
 		return BoolPacking_e::CONST;
 
+	if ( (size_t)m_iRuns*MIN_RLE_AVG_RUN <= m_dCollected.size() )
+		return BoolPacking_e::RLE;
+
 	return BoolPacking_e::BITMAP;
 }
 
@@ -160,6 +180,10 @@ void Packer_Bool_c::WriteToFile ( BoolPacking_e ePacking )
 		WritePacked_Bitmap();
 		break;
 
+	case BoolPacking_e::RLE:
+		WritePacked_RLE();
+		break;
+
 	default:
 		assert ( 0 && "Unknown packing" );
 		break;
@@ -180,6 +204,8 @@ void Packer_Bool_c::Flush()
 	m_bFirst = true;
 	m_bConst = true;
 	m_bConstValue = false;
+	m_bPrevValue = false;
+	m_iRuns = 0;
 }
 
 
@@ -214,6 +240,23 @@ void Packer_Bool_c::WritePacked_Bitmap()
 	}
 }
 
+
+void Packer_Bool_c::WritePacked_RLE()
+{
+	m_dRunEnds.resize(0);
+	for ( size_t i = 1; i < m_dCollected.size(); i++ )
+		if ( m_dCollected[i]!=m_dCollected[i-1] )
+			m_dRunEnds.push_back ( (uint32_t)i );
+
+	m_dRunEnds.push_back ( (uint32_t)m_dCollected.size() );
+	assert ( m_dRunEnds.size()==(size_t)m_iRuns );
+
+	// runs alternate, so only the value of the first run is stored
+	m_tWriter.Write_uint8 ( m_dCollected[0] ? 1 : 0 );
+	m_tWriter.Pack_uint32 ( (uint32_t)m_dRunEnds.size() );
+	WriteValues_Delta_PFOR ( Span_T<uint32_t>(m_dRunEnds), m_dUncompressed, m_dCompressed, m_tWriter, m_pCodec.get() );
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 Packer_i * CreatePackerBool ( const Settings_t & tSettings, const std::string & sName )
@@ -25,6 +25,7 @@ enum class BoolPacking_e : uint32_t
 {
 	CONST,
 	BITMAP,
+	RLE,
 
 	TOTAL
 };
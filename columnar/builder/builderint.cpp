@@ -17,6 +17,7 @@
 #include "builderint.h"
 #include "buildertraits.h"
 #include "builderminmax.h"
+#include "builderbloom.h"
 
 #include <unordered_map>
 #include <algorithm>
@@ -27,6 +28,14 @@ namespace columnar
 using namespace util;
 using namespace common;
 
+// const, table and rle blocks are cheap to scan and are pruned well enough by minmax
+static bool NeedBloomFilter ( uint32_t uPacking )
+{
+	auto ePacking = (IntPacking_e)uPacking;
+	return ePacking!=IntPacking_e::CONST && ePacking!=IntPacking_e::TABLE && ePacking!=IntPacking_e::RLE;
+}
+
+
 template <typename T>
 class AttributeHeaderBuilder_Int_T : public AttributeHeaderBuilder_c
 {
@@ -36,26 +45,81 @@ public:
 			AttributeHeaderBuilder_Int_T ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType );
 
 	bool	Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError );
-	void	Add ( T tValue ) { m_tMinMax.Add(tValue); }
+	void	Add ( T tValue );
+	void	AddBlock ( uint64_t uOffset, uint32_t uPacking );
 
 protected:
 	MinMaxBuilder_T<T>	m_tMinMax;
+	BloomBuilder_c		m_tBloom;
+	T					m_tPrevValue = T(0);
+	bool				m_bHaveValues = false;
+	bool				m_bSortedAsc = true;
+	bool				m_bSortedDesc = true;
+	bool				m_bBloom = false;
 };
 
 template <typename T>
 AttributeHeaderBuilder_Int_T<T>::AttributeHeaderBuilder_Int_T ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType )
 	: BASE ( tSettings, sName, eType )
 	, m_tMinMax ( tSettings )
+	, m_bBloom ( std::is_integral_v<T> && tSettings.m_bIntBloomFilters )
 {}
 
 template <typename T>
 bool AttributeHeaderBuilder_Int_T<T>::Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError )
 {
+	// constant columns are reported as ascending
+	bool bSorted = m_bHaveValues && ( m_bSortedAsc || m_bSortedDesc );
+	if ( bSorted )
+		BASE::SetSortOrder ( m_bSortedAsc ? SortOrder_e::ASC : SortOrder_e::DESC );
+
 	if ( !BASE::Save ( tWriter, tBaseOffset, sError ) )
 		return false;
 
 	tWriter.Write_uint8(1);	// means we have minmax
-	return m_tMinMax.Save ( tWriter, sError );
+	if ( !m_tMinMax.Save ( tWriter, sError ) )
+		return false;
+
+	// sorted attributes are already pruned exactly by minmax
+	if ( !m_bBloom || bSorted )
+	{
+		tWriter.Write_uint8(0);	// no bloom filters
+		return !tWriter.IsError();
+	}
+
+	return m_tBloom.Save(tWriter);
+}
+
+template <typename T>
+void AttributeHeaderBuilder_Int_T<T>::Add ( T tValue )
+{
+	m_tMinMax.Add(tValue);
+
+	if ( m_bHaveValues )
+	{
+		m_bSortedAsc  &= tValue>=m_tPrevValue;
+		m_bSortedDesc &= tValue<=m_tPrevValue;
+	}
+
+	m_tPrevValue = tValue;
+	m_bHaveValues = true;
+
+	if ( m_bBloom )
+		m_tBloom.Add ( (uint64_t)tValue );
+}
+
+template <typename T>
+void AttributeHeaderBuilder_Int_T<T>::AddBlock ( uint64_t uOffset, uint32_t uPacking )
+{
+	if ( m_bBloom )
+	{
+		if ( NeedBloomFilter(uPacking) )
+			m_tBloom.Flush();
+		else
+			m_tBloom.Skip();
+	}
+
+	BASE::AddBlock ( uOffset, uPacking );
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -67,17 +131,32 @@ class AttributeHeaderBuilder_Hash_c : public AttributeHeaderBuilder_c
 
 public:
 	bool	Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError );
-	void	Add ( uint64_t tValue ) {}
+	void	Add ( uint64_t tValue )	{ m_tBloom.Add(tValue); }
+	void	AddBlock ( uint64_t uOffset, uint32_t uPacking );
+
+private:
+	BloomBuilder_c	m_tBloom;
 };
 
 
+void AttributeHeaderBuilder_Hash_c::AddBlock ( uint64_t uOffset, uint32_t uPacking )
+{
+	if ( NeedBloomFilter(uPacking) )
+		m_tBloom.Flush();
+	else
+		m_tBloom.Skip();
+
+	BASE::AddBlock ( uOffset, uPacking );
+}
+
+
 bool AttributeHeaderBuilder_Hash_c::Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError )
 {
 	if ( !BASE::Save ( tWriter, tBaseOffset, sError ) )
 		return false;
 
 	tWriter.Write_uint8(0);	// no minmax
-	return !tWriter.IsError();
+	return m_tBloom.Save(tWriter);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -98,6 +177,7 @@ public:
 	void				Flush() override;
 
 	void				OverridePacking ( IntPacking_e eSrc, IntPacking_e eDst );
+	void				EnableDeltasOfDeltas()	{ m_bDeltasOfDeltas = true; }
 
 private:
 	T						m_tMin = T(0);
@@ -107,20 +187,27 @@ private:
 	std::unordered_map<T,int> m_hUnique { DOCS_PER_BLOCK };
 	std::vector<T>			m_dUniques;
 	int						m_iUniques = 0;
+	int						m_iRuns = 0;
 	std::vector<uint32_t>	m_dTableIndexes;
 	std::vector<uint32_t>	m_dTablePacked;
 
 	bool					m_bMonoAsc = true;
 	bool					m_bMonoDesc = true;
+	bool					m_bDeltasOfDeltas = false;
 	std::vector<uint8_t>	m_dTmpBuffer;
 	std::vector<T>			m_dCollected;
 
 	IntCodecPooledPtr_t			m_pCodec;
+	SubblockCodecChooser_c	m_tCodecs;
 	std::vector<uint32_t>	m_dCompressed;
 	std::vector<T>			m_dUncompressed;
 	std::vector<uint32_t>	m_dUncompressed32;
 	std::vector<uint8_t>	m_dTmpBuffer2;
+	std::vector<uint8_t>	m_dTmpBuffer3;
 	std::vector<uint32_t>	m_dSubblockSizes;
+	std::vector<T>			m_dFloatEncoded;
+	std::vector<T>			m_dRunValues;
+	std::vector<uint32_t>	m_dRunEnds;
 
 	IntPacking_e			m_dPackingOverrides[to_underlying(IntPacking_e::TOTAL)];
 
@@ -130,9 +217,12 @@ private:
 
 	void				WritePacked_Const();
 	void				WritePacked_Table();
+	void				WritePacked_RLE();
 
 	template <typename U, typename WRITER>
-	void				WriteSubblock_Delta ( const Span_T<U> & dSubblockValues, WRITER & tWriter, std::vector<U> & dTmp, bool bWriteFlag );
+	void				WriteSubblock_Delta ( const Span_T<U> & dSubblockValues, WRITER & tWriter, std::vector<U> & dTmp, bool bWriteFlag, IntCodec_c * pCodec );
+
+	void				WriteSubblock_DeltaOfDelta ( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter, IntCodec_c * pCodec );
 
 	template <typename U>
 	bool				WriteNullMap ( const Span_T<U> & dSubblockValues, MemWriter_c & tWriter );
@@ -140,6 +230,10 @@ private:
 	template <typename U>
 	void				WriteSubblock_Hash ( const Span_T<U> & dSubblockValues, MemWriter_c & tWriter );
 
+	void				WriteSubblock_Float ( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter );
+	void				WriteSubblock_Adaptive ( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter, IntPacking_e ePacking );
+	int					ChooseDecimalExp ( const Span_T<T> & dSubblockValues );
+
 	template <typename WRITESUBBLOCK>
 	void				WritePackedSubblocks ( IntPacking_e ePacking, WRITESUBBLOCK && fnWriteSubblock );
 };
@@ -148,6 +242,7 @@ template <typename T, typename HEADER>
 Packer_Int_T<T,HEADER>::Packer_Int_T ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType )
 	: BASE ( tSettings, sName, eType )
 	, m_pCodec ( CreateIntCodec ( tSettings.m_sCompressionUINT32, tSettings.m_sCompressionUINT64 ) )
+	, m_tCodecs ( tSettings )
 {
 	assert ( !(tSettings.m_iSubblockSize & 127) );
 	m_dTableIndexes.resize ( tSettings.m_iSubblockSize );
@@ -183,6 +278,9 @@ void Packer_Int_T<T,HEADER>::AnalyzeCollected ( int64_t tAttr )
 {
 	T tValue = (T)tAttr;
 
+	if ( !m_iUniques || tValue!=m_tPrevValue )
+		m_iRuns++;
+
 	if ( !m_iUniques )
 	{
 		m_tMin = tValue;
@@ -215,6 +313,10 @@ IntPacking_e Packer_Int_T<T,HEADER>::ChoosePacking() const
 	if ( m_iUniques==1 )
 		return m_dPackingOverrides[to_underlying(IntPacking_e::CONST)];
 
+	// long runs of repeated values (sorted or clustered columns) are cheaper to store as (value, run end) pairs
+	if ( (size_t)m_iRuns*MIN_RLE_AVG_RUN <= m_dCollected.size() )
+		return m_dPackingOverrides[to_underlying(IntPacking_e::RLE)];
+
 	if ( m_iUniques<256 )
 		return m_dPackingOverrides[to_underlying(IntPacking_e::TABLE)];
 
@@ -239,15 +341,14 @@ void Packer_Int_T<T,HEADER>::WriteToFile ( IntPacking_e ePacking )
 		WritePacked_Table();
 		break;
 
-	case IntPacking_e::DELTA:
-		WritePackedSubblocks ( ePacking, [this]( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter )
-			{ WriteSubblock_Delta ( dSubblockValues, tWriter, m_dUncompressed, true ); }
-		);
+	case IntPacking_e::RLE:
+		WritePacked_RLE();
 		break;
 
+	case IntPacking_e::DELTA:
 	case IntPacking_e::GENERIC:
-		WritePackedSubblocks ( ePacking, [this]( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter )
-			{ WriteValues_PFOR ( dSubblockValues, m_dUncompressed, m_dCompressed, tWriter, m_pCodec.get(), false ); }
+		WritePackedSubblocks ( ePacking, [this,ePacking]( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter )
+			{ WriteSubblock_Adaptive ( dSubblockValues, tWriter, ePacking ); }
 		);
 		break;
 
@@ -257,6 +358,12 @@ void Packer_Int_T<T,HEADER>::WriteToFile ( IntPacking_e ePacking )
 		);
 		break;
 
+	case IntPacking_e::FLOAT:
+		WritePackedSubblocks ( ePacking, [this]( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter )
+			{ WriteSubblock_Float ( dSubblockValues, tWriter ); }
+		);
+		break;
+
 	default:
 		assert ( 0 && "Unknown packing" );
 		break;
@@ -277,6 +384,7 @@ void Packer_Int_T<T,HEADER>::Flush()
 	m_hUnique.clear();
 	m_tPrevValue = 0;
 	m_iUniques = 0;
+	m_iRuns = 0;
 	m_bMonoAsc = m_bMonoDesc = true;
 }
 
@@ -316,9 +424,34 @@ void Packer_Int_T<T,HEADER>::WritePacked_Table()
 	WriteTableOrdinals ( m_dUniques, m_hUnique, m_dCollected, m_dTableIndexes, m_dTablePacked, m_tHeader.GetSettings().m_iSubblockSize, m_tWriter );
 }
 
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::WritePacked_RLE()
+{
+	m_dRunValues.resize(0);
+	m_dRunEnds.resize(0);
+	for ( size_t i = 0; i < m_dCollected.size(); i++ )
+	{
+		if ( i && m_dCollected[i]==m_dRunValues.back() )
+		{
+			m_dRunEnds.back()++;
+			continue;
+		}
+
+		m_dRunValues.push_back ( m_dCollected[i] );
+		m_dRunEnds.push_back ( uint32_t(i+1) );
+	}
+
+	assert ( m_dRunValues.size()==(size_t)m_iRuns );
+
+	// run values are PFOR-packed, run ends (exclusive, in-block) are delta-packed
+	m_tWriter.Pack_uint32 ( (uint32_t)m_dRunValues.size() );
+	WriteValues_PFOR ( Span_T<T>(m_dRunValues), m_dUncompressed, m_dCompressed, m_tWriter, m_pCodec.get(), true );
+	WriteValues_Delta_PFOR ( Span_T<uint32_t>(m_dRunEnds), m_dUncompressed32, m_dCompressed, m_tWriter, m_pCodec.get() );
+}
+
 template <typename T, typename HEADER>
 template <typename U, typename WRITER>
-void Packer_Int_T<T,HEADER>::WriteSubblock_Delta ( const Span_T<U> & dSubblockValues, WRITER & tWriter, std::vector<U> & dTmp, bool bWriteFlag )
+void Packer_Int_T<T,HEADER>::WriteSubblock_Delta ( const Span_T<U> & dSubblockValues, WRITER & tWriter, std::vector<U> & dTmp, bool bWriteFlag, IntCodec_c * pCodec )
 {
 	dTmp.resize ( dSubblockValues.size() );
 	memcpy ( dTmp.data(), dSubblockValues.data(), dSubblockValues.size()*sizeof(dSubblockValues[0]) );
@@ -330,14 +463,39 @@ void Packer_Int_T<T,HEADER>::WriteSubblock_Delta ( const Span_T<U> & dSubblockVa
 	if ( bAsc )
 	{
 		Span_T<U> tUncompressed(dTmp);
-		m_pCodec->EncodeDelta ( tUncompressed, m_dCompressed );
+		pCodec->EncodeDelta ( tUncompressed, m_dCompressed );
 	}
 	else
 	{
 		ComputeDeltas ( dTmp.data(), (int)dTmp.size(), false );
-		m_pCodec->Encode ( dTmp, m_dCompressed );
+		pCodec->Encode ( dTmp, m_dCompressed );
+	}
+
+	tWriter.Write ( (uint8_t*)m_dCompressed.data(), m_dCompressed.size()*sizeof ( m_dCompressed[0] ) );
+}
+
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::WriteSubblock_DeltaOfDelta ( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter, IntCodec_c * pCodec )
+{
+	// regularly spaced values have near-constant deltas, but irregular ones may be cheaper as plain deltas; keep the smaller one
+	m_dTmpBuffer3.resize(0);
+	MemWriter_c tDeltaWriter(m_dTmpBuffer3);
+	WriteSubblock_Delta ( dSubblockValues, tDeltaWriter, m_dUncompressed, true, pCodec );
+
+	m_dUncompressed.resize ( dSubblockValues.size() );
+	memcpy ( m_dUncompressed.data(), dSubblockValues.data(), dSubblockValues.size()*sizeof(dSubblockValues[0]) );
+	ComputeDeltasOfDeltas ( m_dUncompressed.data(), m_dUncompressed.size() );
+	pCodec->Encode ( m_dUncompressed, m_dCompressed );
+
+	size_t tDoDSize = 1 + ByteCodec_c::CalcPackedLen ( (uint64_t)dSubblockValues[0] ) + m_dCompressed.size()*sizeof(m_dCompressed[0]);
+	if ( tDoDSize>=m_dTmpBuffer3.size() )
+	{
+		tWriter.Write ( m_dTmpBuffer3.data(), m_dTmpBuffer3.size() );
+		return;
 	}
 
+	tWriter.Write_uint8 ( to_underlying ( IntDeltaPacking_e::DELTA_OF_DELTA ) );
+	tWriter.Pack_uint64 ( (uint64_t)dSubblockValues[0] );
 	tWriter.Write ( (uint8_t*)m_dCompressed.data(), m_dCompressed.size()*sizeof ( m_dCompressed[0] ) );
 }
 
@@ -390,6 +548,71 @@ void Packer_Int_T<T,HEADER>::WriteSubblock_Hash ( const Span_T<U> & dSubblockVal
 			tWriter.Write_uint64(i);
 }
 
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::WriteSubblock_Adaptive ( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter, IntPacking_e ePacking )
+{
+	m_tCodecs.Write ( tWriter, [this,&dSubblockValues,ePacking]( MemWriter_c & tEncoded, IntCodec_c * pCodec )
+		{
+			if ( ePacking==IntPacking_e::DELTA && m_bDeltasOfDeltas )
+				WriteSubblock_DeltaOfDelta ( dSubblockValues, tEncoded, pCodec );
+			else if ( ePacking==IntPacking_e::DELTA )
+				WriteSubblock_Delta ( dSubblockValues, tEncoded, m_dUncompressed, true, pCodec );
+			else
+				WriteValues_PFOR ( dSubblockValues, m_dUncompressed, m_dCompressed, tEncoded, pCodec, false );
+		}
+	);
+}
+
+template <typename T, typename HEADER>
+int Packer_Int_T<T,HEADER>::ChooseDecimalExp ( const Span_T<T> & dSubblockValues )
+{
+	// pick the smallest exponent that round-trips every value in the subblock
+	m_dFloatEncoded.resize ( dSubblockValues.size() );
+	for ( int iExp = 0; iExp <= MAX_FLOAT_DECIMAL_EXP; iExp++ )
+	{
+		bool bOk = true;
+		for ( size_t i = 0; i < dSubblockValues.size() && bOk; i++ )
+		{
+			int32_t iDecimal = 0;
+			bOk = FloatToDecimal ( UintToFloat ( (uint32_t)dSubblockValues[i] ), iExp, iDecimal );
+			m_dFloatEncoded[i] = T ( uint32_t(iDecimal) ^ 0x80000000 );	// keep the order for PFOR min subtraction
+		}
+
+		if ( bOk )
+			return iExp;
+	}
+
+	return -1;
+}
+
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::WriteSubblock_Float ( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter )
+{
+	if constexpr ( std::is_same_v<T,uint32_t> )
+	{
+		int iExp = ChooseDecimalExp(dSubblockValues);
+		if ( iExp>=0 )
+		{
+			tWriter.Write_uint8 ( to_underlying ( FloatPacking_e::DECIMAL ) );
+			tWriter.Write_uint8 ( (uint8_t)iExp );
+		}
+		else
+		{
+			// close values share sign, exponent and high mantissa bits, so xor-ed neighbours have lots of leading zeroes
+			m_dFloatEncoded.resize ( dSubblockValues.size() );
+			memcpy ( m_dFloatEncoded.data(), dSubblockValues.data(), dSubblockValues.size()*sizeof(dSubblockValues[0]) );
+			ComputeXorDeltas ( m_dFloatEncoded.data(), (int)m_dFloatEncoded.size() );
+			tWriter.Write_uint8 ( to_underlying ( FloatPacking_e::XOR ) );
+		}
+
+		m_tCodecs.Write ( tWriter, [this]( MemWriter_c & tEncoded, IntCodec_c * pCodec )
+			{ WriteValues_PFOR ( Span_T<T>(m_dFloatEncoded), m_dUncompressed, m_dCompressed, tEncoded, pCodec, false ); }
+		);
+	}
+	else
+		assert ( 0 && "INTERNAL ERROR: float packing of a 64-bit attribute" );
+}
+
 template <typename T, typename HEADER>
 template <typename WRITESUBBLOCK>
 void Packer_Int_T<T,HEADER>::WritePackedSubblocks ( IntPacking_e ePacking, WRITESUBBLOCK && fnWriteSubblock )
@@ -398,6 +621,7 @@ void Packer_Int_T<T,HEADER>::WritePackedSubblocks ( IntPacking_e ePacking, WRITE
 	int iBlocks = ( (int)m_dCollected.size() + iSubblockSize - 1 ) / iSubblockSize;
 
 	m_dSubblockSizes.resize(iBlocks);
+	m_tCodecs.StartBlock(iBlocks);
 
 	m_dTmpBuffer.resize(0);
 	MemWriter_c tMemWriter(m_dTmpBuffer);
@@ -407,6 +631,7 @@ void Packer_Int_T<T,HEADER>::WritePackedSubblocks ( IntPacking_e ePacking, WRITE
 	{
 		int iBlockValues = GetSubblockSize ( iBlock, iBlocks, (int)m_dCollected.size(), iSubblockSize );
 
+		m_tCodecs.StartSubblock(iBlock);
 		int64_t iSubblockStart = tMemWriter.GetPos();
 		fnWriteSubblock ( Span_T<T> ( &m_dCollected[iBlockStart], iBlockValues ), tMemWriter );
 		m_dSubblockSizes[iBlock] = uint32_t ( tMemWriter.GetPos()-iSubblockStart );
@@ -420,13 +645,16 @@ void Packer_Int_T<T,HEADER>::WritePackedSubblocks ( IntPacking_e ePacking, WRITE
 
 	// note that these are 32-bit uints
 	ComputeInverseDeltas ( m_dSubblockSizes, true );
-	WriteSubblock_Delta ( Span_T<uint32_t>(m_dSubblockSizes), tMemWriterSizes, m_dUncompressed32, false );
+	WriteSubblock_Delta ( Span_T<uint32_t>(m_dSubblockSizes), tMemWriterSizes, m_dUncompressed32, false, m_pCodec.get() );
 
 	m_tWriter.Pack_uint32 ( (uint32_t)m_dTmpBuffer2.size() );
 
 	// write compressed sub-block lengths
 	m_tWriter.Write ( m_dTmpBuffer2.data(), m_dTmpBuffer2.size()*sizeof ( m_dTmpBuffer2[0] ) );
 
+	// write per-subblock codecs
+	m_tCodecs.Save(m_tWriter);
+
 	// write the compressed sub-blocks
 	m_tWriter.Write ( m_dTmpBuffer.data(), m_dTmpBuffer.size()*sizeof ( m_dTmpBuffer[0] ) );
 }
@@ -438,7 +666,18 @@ class Packer_Float_c : public Packer_Int_T<uint32_t, AttributeHeaderBuilder_Int_
 	using BASE = Packer_Int_T<uint32_t, AttributeHeaderBuilder_Int_T<float>>;
 
 public:
-	Packer_Float_c ( const Settings_t & tSettings, const std::string & sName ) : BASE ( tSettings, sName, AttrType_e::FLOAT ) {}
+	Packer_Float_c ( const Settings_t & tSettings, const std::string & sName ) : BASE ( tSettings, sName, AttrType_e::FLOAT ) { OverridePacking ( IntPacking_e::GENERIC, IntPacking_e::FLOAT ); }
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+// same storage as UINT32, but sorted subblocks may use second-order deltas
+class Packer_Timestamp_c : public Packer_Int_T<uint32_t, AttributeHeaderBuilder_Int_T<uint32_t>>
+{
+	using BASE = Packer_Int_T<uint32_t, AttributeHeaderBuilder_Int_T<uint32_t>>;
+
+public:
+	Packer_Timestamp_c ( const Settings_t & tSettings, const std::string & sName ) : BASE ( tSettings, sName, AttrType_e::UINT32 ) { EnableDeltasOfDeltas(); }
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -480,6 +719,12 @@ Packer_i * CreatePackerUint32 ( const Settings_t & tSettings, const std::string
 }
 
 
+Packer_i * CreatePackerTimestamp ( const Settings_t & tSettings, const std::string & sName )
+{
+	return new Packer_Timestamp_c ( tSettings, sName );
+}
+
+
 Packer_i * CreatePackerInt64 ( const Settings_t & tSettings, const std::string & sName )
 {
 	return new Packer_Int_T<uint64_t,AttributeHeaderBuilder_Int_T<int64_t>> ( tSettings, sName, AttrType_e::INT64 );
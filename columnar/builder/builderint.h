@@ -24,7 +24,8 @@ namespace columnar
 enum class IntDeltaPacking_e : uint8_t
 {
 	DELTA_ASC,
-	DELTA_DESC
+	DELTA_DESC,
+	DELTA_OF_DELTA	// zigzag-encoded second-order deltas; written by timestamp packers only
 };
 
 
@@ -35,14 +36,24 @@ enum class IntPacking_e : uint32_t
 	DELTA,
 	GENERIC,
 	HASH,
+	FLOAT,
+	RLE,
 
 	TOTAL
 };
 
+// per-subblock encoding used by IntPacking_e::FLOAT
+enum class FloatPacking_e : uint8_t
+{
+	DECIMAL,	// scaled to integers by 10^exp
+	XOR			// bit patterns xor'ed with the previous value
+};
+
 class Packer_i;
 struct Settings_t;
 
 Packer_i * CreatePackerUint32 ( const Settings_t & tSettings, const std::string & sName );
+Packer_i * CreatePackerTimestamp ( const Settings_t & tSettings, const std::string & sName );
 Packer_i * CreatePackerInt64 ( const Settings_t & tSettings, const std::string & sName );
 Packer_i * CreatePackerHash ( const Settings_t & tSettings, const std::string & sName, common::StringHash_fn fnCalcHash );
 Packer_i * CreatePackerFloat ( const Settings_t & tSettings, const std::string & sName );
@@ -53,7 +53,11 @@ bool AttributeHeaderBuilder_MVA_T<T>::Save ( FileWriter_c & tWriter, int64_t & t
 		return false;
 
 	tWriter.Write_uint8(1); // minmax presence flag
-	return m_tMinMax.Save ( tWriter, sError );
+	if ( !m_tMinMax.Save ( tWriter, sError ) )
+		return false;
+
+	tWriter.Write_uint8(0); // bloom filters presence flag
+	return !tWriter.IsError();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -97,6 +101,7 @@ private:
 	std::vector<T>				m_dUncompressed;
 	std::vector<uint32_t>		m_dCompressed;
 	IntCodecPooledPtr_t			m_pCodec;
+	SubblockCodecChooser_c		m_tCodecs;
 
 	MvaPacking_e				m_dPackingOverrides[to_underlying(MvaPacking_e::TOTAL)];
 
@@ -130,6 +135,7 @@ template <typename T, typename HEADER_T>
 Packer_MVA_T<T,HEADER_T>::Packer_MVA_T ( const Settings_t & tSettings, const std::string & sName, AttrType_e eAttr )
 	: BASE ( tSettings, sName, eAttr )
 	, m_pCodec ( CreateIntCodec ( tSettings.m_sCompressionUINT32, tSettings.m_sCompressionUINT64 ) )
+	, m_tCodecs ( tSettings )
 {
 	m_dTableIndexes.resize ( tSettings.m_iSubblockSize );
 
@@ -408,6 +414,7 @@ void Packer_MVA_T<T,HEADER_T>::WritePacked_DeltaPFOR ( bool bWriteLengths )
 	int iBlocks = ( (int)m_dCollectedLengths.size() + iSubblockSize - 1 ) / iSubblockSize;
 
 	m_dSubblockSizes.resize(iBlocks);
+	m_tCodecs.StartBlock(iBlocks);
 
 	m_dTmpBuffer.resize(0);
 	MemWriter_c tMemWriter ( m_dTmpBuffer );
@@ -424,23 +431,33 @@ void Packer_MVA_T<T,HEADER_T>::WritePacked_DeltaPFOR ( bool bWriteLengths )
 		uint32_t uNumValues = 0;
 		if ( bWriteLengths )
 		{
-			WriteValues_PFOR ( dLengths, m_dUncompressed32, m_dCompressed, tMemWriter, m_pCodec.get(), true );
 			for ( auto i : dLengths )
 				uNumValues += i;
 		}
 		else
 			uNumValues = m_iConstLength*iBlockValues;
 
+		// values are delta-encoded in place, so do it once before trying the codecs
+		Span_T<T> dValuesToWrite;
 		if ( uNumValues )
 		{
-			// write bodies	
-			Span_T<T> dValuesToWrite ( &m_dCollectedValues[uTotalValues], uNumValues );
+			dValuesToWrite = Span_T<T> ( &m_dCollectedValues[uTotalValues], uNumValues );
 			if ( m_bValuesSortedAsc )
 				PrepareValues ( dValuesToWrite, dLengths );
-
-			WriteValues_PFOR ( dValuesToWrite, m_dUncompressed, m_dCompressed, tMemWriter, m_pCodec.get(), false );
 		}
 
+		m_tCodecs.StartSubblock(iBlock);
+		m_tCodecs.Write ( tMemWriter, [this, &dLengths, &dValuesToWrite, bWriteLengths]( MemWriter_c & tEncoded, IntCodec_c * pCodec )
+			{
+				if ( bWriteLengths )
+					WriteValues_PFOR ( dLengths, m_dUncompressed32, m_dCompressed, tEncoded, pCodec, true );
+
+				// write bodies
+				if ( !dValuesToWrite.empty() )
+					WriteValues_PFOR ( dValuesToWrite, m_dUncompressed, m_dCompressed, tEncoded, pCodec, false );
+			}
+		);
+
 		m_dSubblockSizes[iBlock] = uint32_t ( tMemWriter.GetPos()-tSubblockStart );
 
 		iBlockStart += iBlockValues;
@@ -448,6 +465,7 @@ void Packer_MVA_T<T,HEADER_T>::WritePacked_DeltaPFOR ( bool bWriteLengths )
 	}
 
 	WriteSubblockSizes();
+	m_tCodecs.Save ( BASE::m_tWriter );
 
 	BASE::m_tWriter.Write ( m_dTmpBuffer.data(), m_dTmpBuffer.size()*sizeof ( m_dTmpBuffer[0] ) );
 }
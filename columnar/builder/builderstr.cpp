@@ -21,6 +21,8 @@
 #include "memory"
 #include <unordered_map>
 #include <algorithm>
+#include <deque>
+#include <string_view>
 
 namespace columnar
 {
@@ -28,6 +30,9 @@ namespace columnar
 using namespace util;
 using namespace common;
 
+// global packing is preferred over table packing unless its codes are wider by more than this
+static const int		GLOBAL_DICT_EXTRA_BITS = 2;
+
 
 class AttributeHeaderBuilder_String_c : public AttributeHeaderBuilder_c
 {
@@ -35,6 +40,9 @@ class AttributeHeaderBuilder_String_c : public AttributeHeaderBuilder_c
 
 public:
 	MinMaxBuilder_T<uint32_t> m_tMinMax;
+	MinMaxBuilder_T<uint64_t> m_tPrefixMinMax;
+	std::deque<std::string>	m_dDictValues;		// append-only; codes of the blocks written earlier stay valid, and so do views into the values
+	int			m_iDictValuesUsed = 0;			// only the part referenced by global blocks is saved
 
 			AttributeHeaderBuilder_String_c ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType );
 
@@ -45,6 +53,7 @@ public:
 AttributeHeaderBuilder_String_c::AttributeHeaderBuilder_String_c ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType )
 	: BASE ( tSettings, sName, eType )
 	, m_tMinMax ( tSettings )
+	, m_tPrefixMinMax ( tSettings )
 {}
 
 
@@ -57,6 +66,20 @@ bool AttributeHeaderBuilder_String_c::Save ( FileWriter_c & tWriter, int64_t & t
 	if ( !m_tMinMax.Save ( tWriter, sError ) )
 		return false;
 
+	tWriter.Write_uint8(0); // bloom filters presence flag; string equality is pruned via the hash attribute
+
+	tWriter.Write_uint8(1); // prefix minmax presence flag
+	if ( !m_tPrefixMinMax.Save ( tWriter, sError ) )
+		return false;
+
+	tWriter.Pack_uint32 ( m_iDictValuesUsed );
+	for ( int i = 0; i < m_iDictValuesUsed; i++ )
+	{
+		const std::string & sValue = m_dDictValues[i];
+		tWriter.Pack_uint32 ( (uint32_t)sValue.length() );
+		tWriter.Write ( (const uint8_t*)sValue.c_str(), sValue.length() );
+	}
+
 	return !tWriter.IsError();
 }
 
@@ -80,6 +103,12 @@ protected:
 	std::vector<std::string>	m_dUniques;
 	std::vector<uint64_t>		m_dOffsets;
 
+	// used by global encoding; the values themselves live in the header
+	std::unordered_map<std::string_view, uint32_t> m_hGlobalDict;
+	int64_t					m_iGlobalDictBytes = 0;
+	bool					m_bGlobalDictRejected = false;	// the column is not low-cardinality; no more global blocks
+	bool					m_bBlockInGlobalDict = true;
+
 	// used by table encoding
 	std::vector<uint32_t>	m_dTableLengths;
 	std::vector<uint32_t>	m_dTableIndexes;
@@ -98,12 +127,14 @@ protected:
 	void					Flush() override;
 	StrPacking_e			ChoosePacking() const;
 	void					AnalyzeCollected ( const uint8_t * pData, int iLength );
+	bool					AddToGlobalDict ( const uint8_t * pData, int iLength );
 	void					WriteToFile ( StrPacking_e ePacking );
 
 	void					WritePacked_Const();
 	void					WritePacked_ConstLen();
 	void					WritePacked_Table();
 	void					WritePacked_Generic();
+	void					WritePacked_Global();
 
 	void					WriteOffsets();
 };
@@ -153,6 +184,7 @@ void Packer_String_c::Flush()
 	m_iUniques = 0;
 	m_hUnique.clear();
 	m_iConstLength = -1;
+	m_bBlockInGlobalDict = !m_bGlobalDictRejected;
 }
 
 
@@ -176,7 +208,35 @@ void Packer_String_c::AnalyzeCollected ( const uint8_t * pData, int iLength )
 		}
 	}
 
+	// no need for further lookups once the block has a value that is not in the dictionary
+	if ( m_bBlockInGlobalDict )
+		m_bBlockInGlobalDict = AddToGlobalDict ( pData, iLength );
+
 	m_tHeader.m_tMinMax.Add(iLength);
+	m_tHeader.m_tPrefixMinMax.Add ( (int64_t)StringPrefixKey ( pData, iLength ) );
+}
+
+
+bool Packer_String_c::AddToGlobalDict ( const uint8_t * pData, int iLength )
+{
+	assert ( !m_bGlobalDictRejected );
+	std::string_view sStr ( (const char*)pData, iLength );
+	if ( m_hGlobalDict.count(sStr) )
+		return true;
+
+	auto & dDict = m_tHeader.m_dDictValues;
+	if ( (int)dDict.size()>=MAX_GLOBAL_DICT_VALUES || m_iGlobalDictBytes+iLength > MAX_GLOBAL_DICT_BYTES )
+	{
+		// the column is not low-cardinality; blocks already written keep their codes, the rest skip the lookups
+		m_bGlobalDictRejected = true;
+		m_hGlobalDict = {};
+		return false;
+	}
+
+	dDict.emplace_back ( sStr );
+	m_hGlobalDict.insert ( { dDict.back(), (uint32_t)dDict.size()-1 } );
+	m_iGlobalDictBytes += iLength;
+	return true;
 }
 
 
@@ -185,6 +245,10 @@ StrPacking_e Packer_String_c::ChoosePacking() const
 	if ( m_iUniques==1 )
 		return StrPacking_e::CONST;
 
+	// over 256 uniques means no table packing
+	if ( m_bBlockInGlobalDict && ( m_iUniques>=256 || CalcNumBits ( m_tHeader.m_dDictValues.size() ) <= CalcNumBits(m_iUniques) + GLOBAL_DICT_EXTRA_BITS ) )
+		return StrPacking_e::GLOBAL;
+
 	if ( m_iUniques<256 )
 		return StrPacking_e::TABLE;
 
@@ -217,6 +281,10 @@ void Packer_String_c::WriteToFile ( StrPacking_e ePacking )
 		WritePacked_Generic();
 		break;
 
+	case StrPacking_e::GLOBAL:
+		WritePacked_Global();
+		break;
+
 	default:
 		assert ( 0 && "Unknown packing" );
 		break;
@@ -314,6 +382,19 @@ void Packer_String_c::WritePacked_Generic()
 }
 
 
+void Packer_String_c::WritePacked_Global()
+{
+	assert ( m_bBlockInGlobalDict );
+
+	// codes are packed with the width of the dictionary at the time the block is written
+	auto & dDict = m_tHeader.m_dDictValues;
+	m_tWriter.Pack_uint32 ( (uint32_t)dDict.size() );
+	WriteTableOrdinals ( dDict, m_hGlobalDict, m_dCollected, m_dTableIndexes, m_dCompressed, m_tHeader.GetSettings().m_iSubblockSize, m_tWriter );
+
+	m_tHeader.m_iDictValuesUsed = (int)dDict.size();
+}
+
+
 void Packer_String_c::WriteOffsets()
 {
 	assert ( !m_dOffsets[0] );
@@ -27,10 +27,15 @@ enum class StrPacking_e : uint32_t
 	CONSTLEN,
 	TABLE,
 	GENERIC,
+	GLOBAL,		// codes into the file-level dictionary stored in the attribute header
 
 	TOTAL
 };
 
+// global dictionary limits; low-cardinality columns fit well below them
+static const int	MAX_GLOBAL_DICT_VALUES = 4096;
+static const int	MAX_GLOBAL_DICT_BYTES = 262144;
+
 class Packer_i;
 struct Settings_t;
 Packer_i * CreatePackerStr ( const Settings_t & tSettings, const std::string & sName );
@@ -62,7 +62,29 @@ bool AttributeHeaderBuilder_c::Save ( FileWriter_c & tWriter, int64_t & tBaseOff
 	for ( auto i : dPackings )
 		tWriter.Pack_uint32(i);
 
+	tWriter.Write_uint8 ( to_underlying(m_eSortOrder) );
+
 	return !tWriter.IsError();
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+SubblockCodecChooser_c::SubblockCodecChooser_c ( const Settings_t & tSettings )
+{
+	const std::string & sAlt32 = GetAltIntCodecName ( tSettings.m_sCompressionUINT32 );
+	const std::string & sAlt64 = GetAltIntCodecName ( tSettings.m_sCompressionUINT64 );
+	m_dCodecs[0] = CreateIntCodec ( tSettings.m_sCompressionUINT32, tSettings.m_sCompressionUINT64 );
+	m_dCodecs[1] = CreateIntCodec ( sAlt32, sAlt64 );
+
+	// both widths usually share a codec; 32-bit cost is a good enough estimate for mixed configs
+	m_dDecodeCost[0] = GetIntCodecDecodeCost ( tSettings.m_sCompressionUINT32 );
+	m_dDecodeCost[1] = GetIntCodecDecodeCost(sAlt32);
+}
+
+
+void SubblockCodecChooser_c::Save ( FileWriter_c & tWriter ) const
+{
+	tWriter.Write ( m_dChosen.data(), m_dChosen.size() );
+}
+
 } // namespace columnar
\ No newline at end of file
@@ -33,12 +33,33 @@ namespace columnar
 
 static const uint32_t	BLOCK_ID_BITS = 16;
 static const int		DOCS_PER_BLOCK = 1 << BLOCK_ID_BITS;
+static const int		MIN_RLE_AVG_RUN = 16;	// blocks with shorter average runs of equal values are not run-length encoded
+
+// first 8 bytes of a string as a big-endian integer; preserves lexicographic order (non-strictly)
+FORCE_INLINE uint64_t StringPrefixKey ( const uint8_t * pStr, int iLength )
+{
+	uint64_t uKey = 0;
+	int iBytes = iLength < (int)sizeof(uKey) ? iLength : (int)sizeof(uKey);
+	for ( int i = 0; i < iBytes; i++ )
+		uKey |= uint64_t(pStr[i]) << ( ( sizeof(uKey)-1-i )*8 );
+
+	return uKey;
+}
+
+// order of attribute values in rowid order
+enum class SortOrder_e : uint8_t
+{
+	NONE,
+	ASC,	// non-decreasing
+	DESC	// non-increasing
+};
 
 struct Settings_t
 {
 	int			m_iSubblockSize = 1024;
 	std::string	m_sCompressionUINT32 = "libstreamvbyte";
 	std::string	m_sCompressionUINT64 = "libstreamvbyte";
+	bool		m_bIntBloomFilters = false;	// build bloom filters for integer attributes (hash attributes always have them); not saved
 
 	void		Load ( util::FileReader_c & tReader );
 	void		Save ( util::FileWriter_c & tWriter );
@@ -52,14 +73,17 @@ public:
 						AttributeHeaderBuilder_c ( const Settings_t & tSettings, const std::string & sName, common::AttrType_e eType );
 
 	common::AttrType_e	GetType() const { return m_eType; }
+	const std::string &	GetName() const { return m_sName; }
 	const Settings_t &	GetSettings() const { return m_tSettings; }
 	void				AddBlock ( uint64_t uOffset, uint32_t uPacking ) { m_dBlocks.push_back ( { uOffset, uPacking } ); }
+	void				SetSortOrder ( SortOrder_e eOrder ) { m_eSortOrder = eOrder; }
 	bool				Save ( util::FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError );
 
 private:
 	std::string			m_sName;
 	common::AttrType_e	m_eType = common::AttrType_e::NONE;
 	Settings_t			m_tSettings;
+	SortOrder_e			m_eSortOrder = SortOrder_e::NONE;
 
 	std::vector<std::pair<int64_t,uint32_t>>	m_dBlocks;
 };
@@ -75,6 +99,8 @@ public:
 	virtual void		AddDoc ( const int64_t * pData, int iLength ) = 0;
 	virtual void		CorrectOffset ( util::FileWriter_c & tWriter, int64_t tBodyOffset ) = 0;
 	virtual int64_t		GetBodySize() const = 0;
+	virtual const std::string & GetName() const = 0;
+	virtual common::AttrType_e GetType() const = 0;
 	virtual void		Done() = 0;
 	virtual void		Cleanup() = 0;
 
@@ -91,6 +117,8 @@ public:
 	bool			Setup ( const std::string & sFilename, size_t tBufferSize, std::string & sError ) override;
 	void			CorrectOffset ( util::FileWriter_c & tWriter, int64_t tBodyOffset ) override;
 	int64_t			GetBodySize() const override { return m_iBodySize; }
+	const std::string & GetName() const override { return m_tHeader.GetName(); }
+	common::AttrType_e GetType() const override { return m_tHeader.GetType(); }
 	void			Done() override;
 	bool			WriteHeader ( util::FileWriter_c & tWriter, std::string & sError ) override;
 	bool			WriteBody ( const std::string & sDest, std::string & sError ) const override;
@@ -217,7 +245,7 @@ void WriteTableOrdinals ( UNIQ_VEC & dUniques, UNIQ_HASH & hUnique, COLLECTED &
 	{
 		auto tFound = hUnique.find(i);
 		assert ( tFound!=hUnique.end() );
-		assert ( tFound->second<256 );
+		assert ( (size_t)tFound->second<dUniques.size() );
 
 		dTableIndexes[iId++] = tFound->second;
 		if ( iId==iSubblockSize )
@@ -237,4 +265,55 @@ void WriteTableOrdinals ( UNIQ_VEC & dUniques, UNIQ_HASH & hUnique, COLLECTED &
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+// encodes each subblock with the configured codec and its alternative and keeps the one with the lowest size*decode cost
+// chosen codec ids go to the block header right after the subblock sizes
+class SubblockCodecChooser_c
+{
+public:
+	static const int NUM_CODECS = 2;
+
+						SubblockCodecChooser_c ( const Settings_t & tSettings );
+
+	void				StartBlock ( int iNumSubblocks )	{ m_dChosen.assign ( iNumSubblocks, 0 ); }
+	void				StartSubblock ( int iSubblock )		{ m_iSubblock = iSubblock; }
+	util::IntCodec_c *	GetDefault() const					{ return m_dCodecs[0].get(); }
+
+	template <typename WRITE>
+	void				Write ( util::MemWriter_c & tWriter, WRITE && fnWrite );
+	void				Save ( util::FileWriter_c & tWriter ) const;
+
+private:
+	std::array<util::IntCodecPooledPtr_t,NUM_CODECS>	m_dCodecs;
+	std::array<float,NUM_CODECS>						m_dDecodeCost;
+	std::array<std::vector<uint8_t>,NUM_CODECS>			m_dEncoded;
+	std::vector<uint8_t>	m_dChosen;
+	int						m_iSubblock = 0;
+};
+
+template <typename WRITE>
+void SubblockCodecChooser_c::Write ( util::MemWriter_c & tWriter, WRITE && fnWrite )
+{
+	int iBest = 0;
+	float fBestCost = 0.0f;
+	for ( int i = 0; i < NUM_CODECS; i++ )
+	{
+		m_dEncoded[i].resize(0);
+		util::MemWriter_c tEncoded ( m_dEncoded[i] );
+		fnWrite ( tEncoded, m_dCodecs[i].get() );
+
+		float fCost = m_dEncoded[i].size()*m_dDecodeCost[i];
+		if ( !i || fCost<fBestCost )
+		{
+			iBest = i;
+			fBestCost = fCost;
+		}
+	}
+
+	assert ( m_iSubblock < (int)m_dChosen.size() );
+	m_dChosen[m_iSubblock] = (uint8_t)iBest;
+	tWriter.Write ( m_dEncoded[iBest].data(), m_dEncoded[iBest].size() );
+}
+
 } // namespace columnar
@@ -21,10 +21,13 @@
 #include "accessorstr.h"
 #include "accessormva.h"
 #include "check.h"
+#include "subblockcache.h"
 #include "reader.h"
 
 #include <unordered_map>
 #include <algorithm>
+#include <array>
+#include <mutex>
 
 namespace columnar
 {
@@ -188,6 +191,718 @@ bool MinMaxEval_T<ROWID_LIMITS,COUNT>::FillMinMax ( int iLevel, int iBlock )
 
 //////////////////////////////////////////////////////////////////////////
 
+enum class Coverage_e
+{
+	NONE,
+	PARTIAL,
+	ALL
+};
+
+// evaluates a filter against single values and against min-max ranges
+class FilterEval_c
+{
+public:
+				FilterEval_c ( const Filter_t & tFilter );
+
+	Coverage_e	Classify ( const std::pair<int64_t,int64_t> & tMinMax ) const;
+	bool		Eval ( int64_t iValue ) const;
+
+	// a single interval (range or one value); only such filters can be resolved into a rowid range over a sorted attribute
+	bool		IsInterval() const;
+	bool		PassesMin ( int64_t iValue ) const;
+	bool		PassesMax ( int64_t iValue ) const;
+
+private:
+	Filter_t	m_tFilter;
+
+	template <typename T> FORCE_INLINE bool PassesLeft ( T tValue, T tMin ) const	{ return m_tFilter.m_bLeftUnbounded || ( m_tFilter.m_bLeftClosed ? tValue>=tMin : tValue>tMin ); }
+	template <typename T> FORCE_INLINE bool PassesRight ( T tValue, T tMax ) const	{ return m_tFilter.m_bRightUnbounded || ( m_tFilter.m_bRightClosed ? tValue<=tMax : tValue<tMax ); }
+	template <typename T> FORCE_INLINE Coverage_e ClassifyRange ( T tMin, T tMax, T tFilterMin, T tFilterMax ) const;
+};
+
+
+FilterEval_c::FilterEval_c ( const Filter_t & tFilter )
+	: m_tFilter ( tFilter )
+{
+	std::sort ( m_tFilter.m_dValues.begin(), m_tFilter.m_dValues.end() );
+}
+
+
+template <typename T>
+Coverage_e FilterEval_c::ClassifyRange ( T tMin, T tMax, T tFilterMin, T tFilterMax ) const
+{
+	if ( !PassesLeft ( tMax, tFilterMin ) || !PassesRight ( tMin, tFilterMax ) )
+		return Coverage_e::NONE;
+
+	if ( PassesLeft ( tMin, tFilterMin ) && PassesRight ( tMax, tFilterMax ) )
+		return Coverage_e::ALL;
+
+	return Coverage_e::PARTIAL;
+}
+
+
+Coverage_e FilterEval_c::Classify ( const std::pair<int64_t,int64_t> & tMinMax ) const
+{
+	switch ( m_tFilter.m_eType )
+	{
+	case FilterType_e::VALUES:
+	{
+		const auto & dValues = m_tFilter.m_dValues;
+		auto tFound = std::lower_bound ( dValues.begin(), dValues.end(), tMinMax.first );
+		bool bAnyInRange = tFound!=dValues.end() && *tFound<=tMinMax.second;
+		if ( !bAnyInRange )
+			return m_tFilter.m_bExclude ? Coverage_e::ALL : Coverage_e::NONE;
+
+		if ( tMinMax.first==tMinMax.second )
+			return m_tFilter.m_bExclude ? Coverage_e::NONE : Coverage_e::ALL;
+
+		return Coverage_e::PARTIAL;
+	}
+
+	case FilterType_e::RANGE:
+		return ClassifyRange ( tMinMax.first, tMinMax.second, m_tFilter.m_iMinValue, m_tFilter.m_iMaxValue );
+
+	case FilterType_e::FLOATRANGE:
+		return ClassifyRange ( UintToFloat ( (uint32_t)tMinMax.first ), UintToFloat ( (uint32_t)tMinMax.second ), m_tFilter.m_fMinValue, m_tFilter.m_fMaxValue );
+
+	default:
+		return Coverage_e::PARTIAL;
+	}
+}
+
+
+bool FilterEval_c::Eval ( int64_t iValue ) const
+{
+	switch ( m_tFilter.m_eType )
+	{
+	case FilterType_e::VALUES:
+		return std::binary_search ( m_tFilter.m_dValues.begin(), m_tFilter.m_dValues.end(), iValue ) ^ m_tFilter.m_bExclude;
+
+	case FilterType_e::RANGE:
+		return PassesLeft ( iValue, m_tFilter.m_iMinValue ) && PassesRight ( iValue, m_tFilter.m_iMaxValue );
+
+	case FilterType_e::FLOATRANGE:
+	{
+		float fValue = UintToFloat ( (uint32_t)iValue );
+		return PassesLeft ( fValue, m_tFilter.m_fMinValue ) && PassesRight ( fValue, m_tFilter.m_fMaxValue );
+	}
+
+	default:
+		return false;
+	}
+}
+
+
+bool FilterEval_c::IsInterval() const
+{
+	switch ( m_tFilter.m_eType )
+	{
+	case FilterType_e::VALUES:		return m_tFilter.m_dValues.size()==1 && !m_tFilter.m_bExclude;
+	case FilterType_e::RANGE:
+	case FilterType_e::FLOATRANGE:	return !m_tFilter.m_bExclude;
+	default:						return false;
+	}
+}
+
+
+bool FilterEval_c::PassesMin ( int64_t iValue ) const
+{
+	switch ( m_tFilter.m_eType )
+	{
+	case FilterType_e::VALUES:		return iValue>=m_tFilter.m_dValues[0];
+	case FilterType_e::RANGE:		return PassesLeft ( iValue, m_tFilter.m_iMinValue );
+	case FilterType_e::FLOATRANGE:	return PassesLeft ( UintToFloat ( (uint32_t)iValue ), m_tFilter.m_fMinValue );
+	default:						return false;
+	}
+}
+
+
+bool FilterEval_c::PassesMax ( int64_t iValue ) const
+{
+	switch ( m_tFilter.m_eType )
+	{
+	case FilterType_e::VALUES:		return iValue<=m_tFilter.m_dValues[0];
+	case FilterType_e::RANGE:		return PassesRight ( iValue, m_tFilter.m_iMaxValue );
+	case FilterType_e::FLOATRANGE:	return PassesRight ( UintToFloat ( (uint32_t)iValue ), m_tFilter.m_fMaxValue );
+	default:						return false;
+	}
+}
+
+
+struct AggrFilter_t
+{
+	const AttributeHeader_i *		m_pHeader = nullptr;
+	std::unique_ptr<FilterEval_c>	m_pEval;
+	std::unique_ptr<ScanCursor_i>	m_pCursor;
+};
+
+
+struct AggrAttr_t
+{
+	AggrFunc_e						m_eFunc = AggrFunc_e::COUNT;
+	const AttributeHeader_i *		m_pHeader = nullptr;
+	bool							m_bFloat = false;
+	std::unique_ptr<ScanCursor_i>	m_pCursor;
+};
+
+// walks the min-max tree; nodes fully covered by all filters are answered from metadata (and CONST/TABLE blocks for SUM)
+// only leaves that partially match are decoded and filtered row by row
+class Aggregator_c
+{
+public:
+			Aggregator_c ( std::vector<AggrFilter_t> & dFilters, std::vector<AggrAttr_t> & dAttrs, const AttributeHeader_i & tTreeHeader, std::vector<AggrResult_t> & dResults );
+
+	void	Aggregate();
+
+private:
+	std::vector<AggrFilter_t> &	m_dFilters;
+	std::vector<AggrAttr_t> &	m_dAttrs;
+	const AttributeHeader_i &	m_tTreeHeader;
+	std::vector<AggrResult_t> &	m_dResults;
+
+	int						m_iNumLevels = 0;
+	int						m_iMinMaxLeafShift = 0;
+	uint32_t				m_uNumDocs = 0;
+	std::vector<uint8_t>	m_dMatches;
+	std::vector<uint8_t>	m_dTableMatches;
+
+	void		DoAggregate ( int iLevel, int iBlock );
+	void		AggregateCovered ( uint32_t tMinRowID, uint32_t tMaxRowID, int iLevel, int iBlock );
+	void		AggregatePartial ( uint32_t tMinRowID, uint32_t tMaxRowID );
+	void		ApplyFilter ( AggrFilter_t & tFilter, uint32_t tMinRowID, uint32_t tMaxRowID );
+	void		AggregateMatches ( int iAttr, uint32_t tMinRowID, uint32_t tMaxRowID );
+	void		AggregateSum ( int iAttr, uint32_t tMinRowID, uint32_t tMaxRowID );
+	void		AddValue ( int iAttr, int64_t iValue, int64_t iCount );
+	void		AddMinMax ( int iAttr, const std::pair<int64_t,int64_t> & tMinMax, int64_t iCount );
+
+	FORCE_INLINE uint32_t NodeId2RowId ( int iBlock, int iLevel ) const { return std::min ( uint32_t ( (uint64_t)iBlock << ( m_iNumLevels - iLevel - 1 + m_iMinMaxLeafShift ) ), m_uNumDocs ); }
+};
+
+
+Aggregator_c::Aggregator_c ( std::vector<AggrFilter_t> & dFilters, std::vector<AggrAttr_t> & dAttrs, const AttributeHeader_i & tTreeHeader, std::vector<AggrResult_t> & dResults )
+	: m_dFilters ( dFilters )
+	, m_dAttrs ( dAttrs )
+	, m_tTreeHeader ( tTreeHeader )
+	, m_dResults ( dResults )
+{
+	m_iNumLevels = tTreeHeader.GetNumMinMaxLevels();
+	m_iMinMaxLeafShift = CalcNumBits ( tTreeHeader.GetSettings().m_iSubblockSize ) - 1;
+	m_uNumDocs = tTreeHeader.GetNumDocs();
+	m_dResults.resize(0);
+	m_dResults.resize ( m_dAttrs.size() );
+}
+
+
+void Aggregator_c::Aggregate()
+{
+	if ( m_iNumLevels )
+	{
+		DoAggregate ( 0, 0 );
+		return;
+	}
+
+	// no min-max tree; process everything subblock by subblock
+	uint32_t uStep = m_tTreeHeader.GetSettings().m_iSubblockSize;
+	for ( uint32_t tRowID = 0; tRowID < m_uNumDocs; tRowID += uStep )
+		AggregatePartial ( tRowID, std::min ( tRowID + uStep, m_uNumDocs ) );
+}
+
+
+void Aggregator_c::DoAggregate ( int iLevel, int iBlock )
+{
+	if ( iBlock>=m_tTreeHeader.GetNumMinMaxBlocks(iLevel) )
+		return;
+
+	Coverage_e eCoverage = Coverage_e::ALL;
+	for ( const auto & i : m_dFilters )
+	{
+		Coverage_e eFilterCoverage = i.m_pEval->Classify ( i.m_pHeader->GetMinMax ( iLevel, iBlock ) );
+		if ( eFilterCoverage==Coverage_e::NONE )
+			return;
+
+		if ( eFilterCoverage==Coverage_e::PARTIAL )
+			eCoverage = Coverage_e::PARTIAL;
+	}
+
+	uint32_t tMinRowID = NodeId2RowId ( iBlock, iLevel );
+	uint32_t tMaxRowID = NodeId2RowId ( iBlock+1, iLevel );
+	if ( tMinRowID>=tMaxRowID )
+		return;
+
+	if ( eCoverage==Coverage_e::ALL )
+	{
+		AggregateCovered ( tMinRowID, tMaxRowID, iLevel, iBlock );
+		return;
+	}
+
+	if ( iLevel<m_iNumLevels-1 )
+	{
+		DoAggregate ( iLevel+1, iBlock<<1 );
+		DoAggregate ( iLevel+1, (iBlock<<1)+1 );
+		return;
+	}
+
+	AggregatePartial ( tMinRowID, tMaxRowID );
+}
+
+
+void Aggregator_c::AggregateCovered ( uint32_t tMinRowID, uint32_t tMaxRowID, int iLevel, int iBlock )
+{
+	int64_t iCount = tMaxRowID-tMinRowID;
+	for ( size_t i = 0; i < m_dAttrs.size(); i++ )
+	{
+		const auto & tAttr = m_dAttrs[i];
+		switch ( tAttr.m_eFunc )
+		{
+		case AggrFunc_e::COUNT:
+			AddValue ( (int)i, 0, iCount );
+			break;
+
+		case AggrFunc_e::MIN:
+		case AggrFunc_e::MAX:
+			if ( tAttr.m_pHeader->GetNumMinMaxLevels() )
+				AddMinMax ( (int)i, tAttr.m_pHeader->GetMinMax ( iLevel, iBlock ), iCount );
+			else
+				AggregateSum ( (int)i, tMinRowID, tMaxRowID );
+			break;
+
+		case AggrFunc_e::SUM:
+			AggregateSum ( (int)i, tMinRowID, tMaxRowID );
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+
+void Aggregator_c::AggregatePartial ( uint32_t tMinRowID, uint32_t tMaxRowID )
+{
+	m_dMatches.resize(0);
+	m_dMatches.resize ( tMaxRowID-tMinRowID, 1 );
+
+	for ( auto & i : m_dFilters )
+		ApplyFilter ( i, tMinRowID, tMaxRowID );
+
+	for ( size_t i = 0; i < m_dAttrs.size(); i++ )
+		AggregateMatches ( (int)i, tMinRowID, tMaxRowID );
+}
+
+
+void Aggregator_c::ApplyFilter ( AggrFilter_t & tFilter, uint32_t tMinRowID, uint32_t tMaxRowID )
+{
+	const FilterEval_c & tEval = *tFilter.m_pEval;
+	ScanCursor_i & tCursor = *tFilter.m_pCursor;
+	tCursor.Reset ( tMinRowID, tMaxRowID );
+
+	ScanSpan_t tSpan;
+	while ( tCursor.GetNextSpan(tSpan) )
+	{
+		uint8_t * pMatch = m_dMatches.data() + ( tSpan.m_tRowID-tMinRowID );
+		switch ( tSpan.m_ePacking )
+		{
+		case ScanPacking_e::CONST:
+			if ( !tEval.Eval ( tSpan.m_iValue ) )
+				memset ( pMatch, 0, tSpan.m_iNumValues );
+			break;
+
+		case ScanPacking_e::TABLE:
+			m_dTableMatches.resize ( tSpan.m_dTable.size() );
+			for ( size_t i = 0; i < tSpan.m_dTable.size(); i++ )
+				m_dTableMatches[i] = tEval.Eval ( tSpan.m_dTable[i] );
+
+			for ( auto i : tSpan.m_dIndexes )
+				*pMatch++ &= m_dTableMatches[i];
+			break;
+
+		default:
+			if ( !tSpan.m_dValues32.empty() )
+			{
+				for ( auto i : tSpan.m_dValues32 )
+					*pMatch++ &= tEval.Eval(i);
+			}
+			else
+			{
+				for ( auto i : tSpan.m_dValues64 )
+					*pMatch++ &= tEval.Eval ( (int64_t)i );
+			}
+			break;
+		}
+	}
+}
+
+
+void Aggregator_c::AggregateMatches ( int iAttr, uint32_t tMinRowID, uint32_t tMaxRowID )
+{
+	auto & tAttr = m_dAttrs[iAttr];
+	if ( tAttr.m_eFunc==AggrFunc_e::COUNT )
+	{
+		int64_t iCount = 0;
+		for ( auto i : m_dMatches )
+			iCount += i;
+
+		AddValue ( iAttr, 0, iCount );
+		return;
+	}
+
+	ScanCursor_i & tCursor = *tAttr.m_pCursor;
+	tCursor.Reset ( tMinRowID, tMaxRowID );
+
+	ScanSpan_t tSpan;
+	while ( tCursor.GetNextSpan(tSpan) )
+	{
+		const uint8_t * pMatch = m_dMatches.data() + ( tSpan.m_tRowID-tMinRowID );
+		switch ( tSpan.m_ePacking )
+		{
+		case ScanPacking_e::CONST:
+		{
+			int64_t iCount = 0;
+			for ( int i = 0; i < tSpan.m_iNumValues; i++ )
+				iCount += pMatch[i];
+
+			if ( iCount )
+				AddValue ( iAttr, tSpan.m_iValue, iCount );
+		}
+		break;
+
+		case ScanPacking_e::TABLE:
+			for ( auto i : tSpan.m_dIndexes )
+				if ( *pMatch++ )
+					AddValue ( iAttr, tSpan.m_dTable[i], 1 );
+			break;
+
+		default:
+			if ( !tSpan.m_dValues32.empty() )
+			{
+				for ( auto i : tSpan.m_dValues32 )
+					if ( *pMatch++ )
+						AddValue ( iAttr, i, 1 );
+			}
+			else
+			{
+				for ( auto i : tSpan.m_dValues64 )
+					if ( *pMatch++ )
+						AddValue ( iAttr, (int64_t)i, 1 );
+			}
+			break;
+		}
+	}
+}
+
+
+void Aggregator_c::AggregateSum ( int iAttr, uint32_t tMinRowID, uint32_t tMaxRowID )
+{
+	ScanCursor_i & tCursor = *m_dAttrs[iAttr].m_pCursor;
+	tCursor.Reset ( tMinRowID, tMaxRowID );
+
+	ScanSpan_t tSpan;
+	while ( tCursor.GetNextSpan(tSpan) )
+	{
+		switch ( tSpan.m_ePacking )
+		{
+		case ScanPacking_e::CONST:
+			AddValue ( iAttr, tSpan.m_iValue, tSpan.m_iNumValues );
+			break;
+
+		case ScanPacking_e::TABLE:
+		{
+			// count table codes first; then each distinct value is added once
+			std::array<int64_t,256> dCounts {};
+			for ( auto i : tSpan.m_dIndexes )
+				dCounts[i]++;
+
+			for ( size_t i = 0; i < tSpan.m_dTable.size(); i++ )
+				if ( dCounts[i] )
+					AddValue ( iAttr, tSpan.m_dTable[i], dCounts[i] );
+		}
+		break;
+
+		default:
+			for ( auto i : tSpan.m_dValues32 )
+				AddValue ( iAttr, i, 1 );
+
+			for ( auto i : tSpan.m_dValues64 )
+				AddValue ( iAttr, (int64_t)i, 1 );
+			break;
+		}
+	}
+}
+
+
+void Aggregator_c::AddValue ( int iAttr, int64_t iValue, int64_t iCount )
+{
+	const auto & tAttr = m_dAttrs[iAttr];
+	auto & tResult = m_dResults[iAttr];
+	bool bFirst = !tResult.m_iCount;
+	tResult.m_iCount += iCount;
+
+	float fValue = UintToFloat ( (uint32_t)iValue );
+	switch ( tAttr.m_eFunc )
+	{
+	case AggrFunc_e::COUNT:
+		tResult.m_iValue += iCount;
+		break;
+
+	case AggrFunc_e::SUM:
+		if ( tAttr.m_bFloat )
+			tResult.m_fValue += (double)fValue*iCount;
+		else
+			tResult.m_iValue += iValue*iCount;
+		break;
+
+	case AggrFunc_e::MIN:
+		if ( tAttr.m_bFloat )
+			tResult.m_fValue = bFirst ? fValue : std::min ( tResult.m_fValue, (double)fValue );
+		else
+			tResult.m_iValue = bFirst ? iValue : std::min ( tResult.m_iValue, iValue );
+		break;
+
+	case AggrFunc_e::MAX:
+		if ( tAttr.m_bFloat )
+			tResult.m_fValue = bFirst ? fValue : std::max ( tResult.m_fValue, (double)fValue );
+		else
+			tResult.m_iValue = bFirst ? iValue : std::max ( tResult.m_iValue, iValue );
+		break;
+
+	default:
+		break;
+	}
+}
+
+
+void Aggregator_c::AddMinMax ( int iAttr, const std::pair<int64_t,int64_t> & tMinMax, int64_t iCount )
+{
+	// min-max tree nodes store exact bounds of their rows, so this is the same as adding every value
+	bool bMin = m_dAttrs[iAttr].m_eFunc==AggrFunc_e::MIN;
+	AddValue ( iAttr, bMin ? tMinMax.first : tMinMax.second, iCount );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// walks the min-max tree best-first (highest max first for DESC, lowest min first for ASC)
+// the walk stops at the first node whose bound can't beat the k-th best row found so far, so usually only a few leaves are decoded
+class TopK_c
+{
+public:
+			TopK_c ( const AttributeHeader_i & tHeader, ScanCursor_i & tCursor, bool bDesc, int iK );
+
+	void	SetRowIdFilter ( BlockIterator_i & tFilter );
+	void	Find();
+	void	GetResult ( std::vector<TopKMatch_t> & dResult );
+
+private:
+	struct Match_t
+	{
+		int64_t		m_iKey = 0;		// order-preserving value; floats are mapped to signed integers
+		uint32_t	m_tRowID = 0;
+		int64_t		m_iValue = 0;
+	};
+
+	struct Node_t
+	{
+		int64_t		m_iKey = 0;		// best key any row of the node can have
+		uint32_t	m_tRowID = 0;	// 1st row of the node
+		int			m_iLevel = 0;
+		int			m_iBlock = 0;
+	};
+
+	const AttributeHeader_i &	m_tHeader;
+	ScanCursor_i &				m_tCursor;
+	bool						m_bDesc = true;
+	bool						m_bFloat = false;
+	size_t						m_tK = 0;
+	int							m_iNumLevels = 0;
+	int							m_iMinMaxLeafShift = 0;
+	uint32_t					m_uNumDocs = 0;
+
+	std::vector<Match_t>		m_dTop;				// heap; the worst of the current best rows is on top
+	std::vector<uint64_t>		m_dFilterRows;		// bitmap of rows passed by the rowid filter; empty if there's no filter
+	std::vector<uint8_t>		m_dFilterLeaves;	// leaves that have at least one such row
+
+	void		ScanLeaf ( uint32_t tMinRowID, uint32_t tMaxRowID );
+	Node_t		MakeNode ( int iLevel, int iBlock ) const;
+
+	FORCE_INLINE bool		IsBetter ( int64_t iKeyA, uint32_t tRowIDA, int64_t iKeyB, uint32_t tRowIDB ) const;
+	FORCE_INLINE bool		CanEnter ( int64_t iKey, uint32_t tRowID ) const	{ return m_dTop.size()<m_tK || IsBetter ( iKey, tRowID, m_dTop[0].m_iKey, m_dTop[0].m_tRowID ); }
+	FORCE_INLINE int64_t	GetKey ( int64_t iValue ) const;
+	FORCE_INLINE void		AddValue ( uint32_t tRowID, int64_t iValue );
+	FORCE_INLINE uint32_t	NodeId2RowId ( int iBlock, int iLevel ) const { return std::min ( uint32_t ( (uint64_t)iBlock << ( m_iNumLevels - iLevel - 1 + m_iMinMaxLeafShift ) ), m_uNumDocs ); }
+};
+
+
+TopK_c::TopK_c ( const AttributeHeader_i & tHeader, ScanCursor_i & tCursor, bool bDesc, int iK )
+	: m_tHeader ( tHeader )
+	, m_tCursor ( tCursor )
+	, m_bDesc ( bDesc )
+	, m_bFloat ( tHeader.GetType()==AttrType_e::FLOAT )
+	, m_tK ( (size_t)std::max ( iK, 0 ) )
+{
+	m_iNumLevels = tHeader.GetNumMinMaxLevels();
+	m_iMinMaxLeafShift = CalcNumBits ( tHeader.GetSettings().m_iSubblockSize ) - 1;
+	m_uNumDocs = tHeader.GetNumDocs();
+}
+
+
+void TopK_c::SetRowIdFilter ( BlockIterator_i & tFilter )
+{
+	// the filter can only be read in rowid order, while leaves are visited in value order; so we collect its rows first
+	m_dFilterRows.resize ( ( m_uNumDocs+63 ) >> 6, 0 );
+	m_dFilterLeaves.resize ( ( m_uNumDocs + ( 1U<<m_iMinMaxLeafShift ) - 1 ) >> m_iMinMaxLeafShift, 0 );
+
+	Span_T<uint32_t> dRowIdBlock;
+	while ( tFilter.GetNextRowIdBlock(dRowIdBlock) )
+		for ( auto i : dRowIdBlock )
+			if ( i<m_uNumDocs )
+			{
+				m_dFilterRows[i>>6] |= 1ULL << ( i & 63 );
+				m_dFilterLeaves[i>>m_iMinMaxLeafShift] = 1;
+			}
+}
+
+
+void TopK_c::Find()
+{
+	if ( !m_tK )
+		return;
+
+	if ( !m_iNumLevels )
+	{
+		uint32_t uStep = 1U << m_iMinMaxLeafShift;
+		for ( uint32_t tRowID = 0; tRowID < m_uNumDocs; tRowID += uStep )
+			if ( m_dFilterLeaves.empty() || m_dFilterLeaves[tRowID>>m_iMinMaxLeafShift] )
+				ScanLeaf ( tRowID, std::min ( tRowID + uStep, m_uNumDocs ) );
+
+		return;
+	}
+
+	// children are never better than their parents, so nodes come out of the heap in non-increasing order
+	auto fnWorse = [this]( const Node_t & tA, const Node_t & tB ){ return IsBetter ( tB.m_iKey, tB.m_tRowID, tA.m_iKey, tA.m_tRowID ); };
+	std::vector<Node_t> dNodes { MakeNode ( 0, 0 ) };
+	while ( !dNodes.empty() )
+	{
+		std::pop_heap ( dNodes.begin(), dNodes.end(), fnWorse );
+		Node_t tNode = dNodes.back();
+		dNodes.pop_back();
+
+		if ( !CanEnter ( tNode.m_iKey, tNode.m_tRowID ) )
+			break;
+
+		if ( tNode.m_iLevel<m_iNumLevels-1 )
+		{
+			int iNumChildren = m_tHeader.GetNumMinMaxBlocks ( tNode.m_iLevel+1 );
+			for ( int iChild = tNode.m_iBlock<<1; iChild <= (tNode.m_iBlock<<1)+1 && iChild<iNumChildren; iChild++ )
+			{
+				dNodes.push_back ( MakeNode ( tNode.m_iLevel+1, iChild ) );
+				std::push_heap ( dNodes.begin(), dNodes.end(), fnWorse );
+			}
+
+			continue;
+		}
+
+		if ( m_dFilterLeaves.empty() || m_dFilterLeaves[tNode.m_iBlock] )
+			ScanLeaf ( NodeId2RowId ( tNode.m_iBlock, tNode.m_iLevel ), NodeId2RowId ( tNode.m_iBlock+1, tNode.m_iLevel ) );
+	}
+}
+
+
+void TopK_c::GetResult ( std::vector<TopKMatch_t> & dResult )
+{
+	std::sort_heap ( m_dTop.begin(), m_dTop.end(), [this]( const Match_t & tA, const Match_t & tB ){ return IsBetter ( tA.m_iKey, tA.m_tRowID, tB.m_iKey, tB.m_tRowID ); } );
+
+	dResult.resize(0);
+	for ( const auto & i : m_dTop )
+		dResult.push_back ( { i.m_tRowID, i.m_iValue } );
+}
+
+
+void TopK_c::ScanLeaf ( uint32_t tMinRowID, uint32_t tMaxRowID )
+{
+	m_tCursor.Reset ( tMinRowID, tMaxRowID );
+
+	ScanSpan_t tSpan;
+	while ( m_tCursor.GetNextSpan(tSpan) )
+	{
+		uint32_t tRowID = tSpan.m_tRowID;
+		switch ( tSpan.m_ePacking )
+		{
+		case ScanPacking_e::CONST:
+		{
+			// same value, increasing rowids: once a row doesn't make it, the rest of the span won't either
+			int64_t iKey = GetKey ( tSpan.m_iValue );
+			for ( int i = 0; i < tSpan.m_iNumValues && CanEnter ( iKey, tRowID ); i++ )
+				AddValue ( tRowID++, tSpan.m_iValue );
+		}
+		break;
+
+		case ScanPacking_e::TABLE:
+			for ( auto i : tSpan.m_dIndexes )
+				AddValue ( tRowID++, tSpan.m_dTable[i] );
+			break;
+
+		default:
+			for ( auto i : tSpan.m_dValues32 )
+				AddValue ( tRowID++, i );
+
+			for ( auto i : tSpan.m_dValues64 )
+				AddValue ( tRowID++, (int64_t)i );
+			break;
+		}
+	}
+}
+
+
+TopK_c::Node_t TopK_c::MakeNode ( int iLevel, int iBlock ) const
+{
+	auto tMinMax = m_tHeader.GetMinMax ( iLevel, iBlock );
+	return { GetKey ( m_bDesc ? tMinMax.second : tMinMax.first ), NodeId2RowId ( iBlock, iLevel ), iLevel, iBlock };
+}
+
+
+bool TopK_c::IsBetter ( int64_t iKeyA, uint32_t tRowIDA, int64_t iKeyB, uint32_t tRowIDB ) const
+{
+	if ( iKeyA!=iKeyB )
+		return m_bDesc ? iKeyA>iKeyB : iKeyA<iKeyB;
+
+	return tRowIDA<tRowIDB;
+}
+
+
+int64_t TopK_c::GetKey ( int64_t iValue ) const
+{
+	if ( !m_bFloat )
+		return iValue;
+
+	// sign-magnitude float bits to a signed integer with the same order
+	uint32_t uValue = (uint32_t)iValue;
+	int64_t iMagnitude = uValue & 0x7FFFFFFF;
+	return ( uValue & 0x80000000 ) ? -iMagnitude : iMagnitude;
+}
+
+
+void TopK_c::AddValue ( uint32_t tRowID, int64_t iValue )
+{
+	int64_t iKey = GetKey(iValue);
+	if ( !CanEnter ( iKey, tRowID ) )
+		return;
+
+	if ( !m_dFilterRows.empty() && !( m_dFilterRows[tRowID>>6] & ( 1ULL << ( tRowID & 63 ) ) ) )
+		return;
+
+	auto fnBetter = [this]( const Match_t & tA, const Match_t & tB ){ return IsBetter ( tA.m_iKey, tA.m_tRowID, tB.m_iKey, tB.m_tRowID ); };
+	if ( m_dTop.size()==m_tK )
+	{
+		std::pop_heap ( m_dTop.begin(), m_dTop.end(), fnBetter );
+		m_dTop.back() = { iKey, tRowID, iValue };
+	}
+	else
+		m_dTop.push_back ( { iKey, tRowID, iValue } );
+
+	std::push_heap ( m_dTop.begin(), m_dTop.end(), fnBetter );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 void Settings_t::Load ( FileReader_c & tReader )
 {
 	m_iSubblockSize		= tReader.Read_uint32();
@@ -267,8 +982,8 @@ bool BlockIterator_c::Setup ( const std::vector<HeaderWithLocator_t> & dHeaders,
 	const AttributeHeader_i * pFirstAttr = dHeaders[0].first;
 	m_iTotalDocs = pFirstAttr->GetNumDocs();
 	m_iNumLevels = pFirstAttr->GetNumMinMaxLevels();
-	m_iNumBlocks = pFirstAttr->GetNumMinMaxBlocks ( m_iNumLevels-1 );
 	m_iDocsPerBlock = pFirstAttr->GetSettings().m_iSubblockSize;
+	m_iNumBlocks = int ( ( m_iTotalDocs + m_iDocsPerBlock - 1 ) / m_iDocsPerBlock );	// same as the number of minmax leaves; bloom-only prefilters have no minmax tree
 	m_iMinMaxLeafShift = CalcNumBits(m_iDocsPerBlock)-1;
 
 	int iLeftover = m_iTotalDocs % m_iDocsPerBlock;
@@ -369,58 +1084,350 @@ int BlockIterator_c::GetNumDocs ( int iBlock ) const
 
 //////////////////////////////////////////////////////////////////////////
 
+// returns every rowid in [tMinRowID,tMaxRowID) that lies in a matching subblock
+// used instead of an analyzer when a filter over a sorted attribute resolves to a single rowid range
+class RowIdRangeIterator_c : public BlockIterator_i
+{
+public:
+				RowIdRangeIterator_c ( const std::string & sAttr, uint32_t tMinRowID, uint32_t tMaxRowID, int iSubblockSize, SharedBlocks_c & pMatchingBlocks );
+
+	bool		HintRowID ( uint32_t tRowID ) final;
+	bool		GetNextRowIdBlock ( Span_T<uint32_t> & dRowIdBlock ) final;
+	int64_t		GetNumProcessed() const final	{ return m_iProcessed; }
+	void		AddDesc ( std::vector<IteratorDesc_t> & dDesc ) const final { dDesc.push_back ( { m_sAttr, "sorted range" } ); }
+
+	void		SetCutoff ( int iCutoff ) final	{ m_iRowsLeft = iCutoff; }
+	bool		WasCutoffHit() const final		{ return !m_iRowsLeft; }
+
+private:
+	static const int MAX_COLLECTED = 1024;
+
+	std::string							m_sAttr;
+	std::shared_ptr<MatchingBlocks_c>	m_pMatchingBlocks;
+	std::array<uint32_t,MAX_COLLECTED>	m_dCollected;
+
+	uint32_t	m_tRowID = 0;
+	uint32_t	m_tMaxRowID = 0;
+	uint32_t	m_tSpanEnd = 0;		// end of the current run of rowids (clamped to the current matching subblock)
+	int			m_iBlock = 0;
+	int			m_iSubblockShift = 0;
+	int			m_iRowsLeft = INT_MAX;
+	int64_t		m_iProcessed = 0;
+
+	bool		SetCurBlock ( int iBlock );
+};
+
+
+RowIdRangeIterator_c::RowIdRangeIterator_c ( const std::string & sAttr, uint32_t tMinRowID, uint32_t tMaxRowID, int iSubblockSize, SharedBlocks_c & pMatchingBlocks )
+	: m_sAttr ( sAttr )
+	, m_pMatchingBlocks ( pMatchingBlocks )
+	, m_tRowID ( tMinRowID )
+	, m_tMaxRowID ( tMaxRowID )
+	, m_tSpanEnd ( tMaxRowID )
+	, m_iSubblockShift ( CalcNumBits(iSubblockSize)-1 )
+{
+	if ( m_pMatchingBlocks )
+		SetCurBlock ( m_pMatchingBlocks->Find ( 0, m_tRowID>>m_iSubblockShift ) );
+}
+
+
+bool RowIdRangeIterator_c::SetCurBlock ( int iBlock )
+{
+	m_iBlock = iBlock;
+	if ( iBlock>=m_pMatchingBlocks->GetNumBlocks() )
+	{
+		m_tRowID = m_tSpanEnd = m_tMaxRowID;
+		return false;
+	}
+
+	uint32_t tSubblockStart = uint32_t ( m_pMatchingBlocks->GetBlock(iBlock) ) << m_iSubblockShift;
+	m_tRowID = std::max ( m_tRowID, tSubblockStart );
+	m_tSpanEnd = std::min ( tSubblockStart + ( 1U<<m_iSubblockShift ), m_tMaxRowID );
+	return true;
+}
+
+
+bool RowIdRangeIterator_c::HintRowID ( uint32_t tRowID )
+{
+	if ( tRowID<=m_tRowID )
+		return m_tRowID<m_tMaxRowID;
+
+	m_tRowID = std::min ( tRowID, m_tMaxRowID );
+	if ( m_pMatchingBlocks && m_tRowID>=m_tSpanEnd )
+		SetCurBlock ( m_pMatchingBlocks->Find ( m_iBlock, m_tRowID>>m_iSubblockShift ) );
+
+	return m_tRowID<m_tMaxRowID;
+}
+
+
+bool RowIdRangeIterator_c::GetNextRowIdBlock ( Span_T<uint32_t> & dRowIdBlock )
+{
+	uint32_t * pRowIdStart = m_dCollected.data();
+	uint32_t * pRowIdMax = pRowIdStart + std::min ( m_iRowsLeft, MAX_COLLECTED );
+	uint32_t * pRowID = pRowIdStart;
+
+	while ( pRowID<pRowIdMax && m_tRowID<m_tMaxRowID )
+	{
+		if ( m_tRowID>=m_tSpanEnd )
+		{
+			if ( !SetCurBlock ( m_iBlock+1 ) )
+				break;
+
+			continue;
+		}
+
+		size_t uNumValues = std::min ( size_t(m_tSpanEnd-m_tRowID), size_t(pRowIdMax-pRowID) );
+		FillWithIncreasingValues ( pRowID, uNumValues, m_tRowID );
+	}
+
+	int iCollected = int(pRowID-pRowIdStart);
+	m_iProcessed += iCollected;
+	m_iRowsLeft = std::max ( m_iRowsLeft - iCollected, 0 );
+	return CheckEmptySpan ( pRowID, pRowIdStart, dRowIdBlock );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// intersects analyzers; the 1st (most selective) one drives the scan
+// the rest are hinted to the rowids it produces, so they only decode subblocks that contain those rowids
+class AndIterator_c : public BlockIterator_i
+{
+public:
+				AndIterator_c ( const std::vector<BlockIterator_i *> & dIterators );
+
+	bool		HintRowID ( uint32_t tRowID ) final	{ return m_pLead->HintRowID(tRowID); }
+	bool		GetNextRowIdBlock ( Span_T<uint32_t> & dRowIdBlock ) final;
+	int64_t		GetNumProcessed() const final;
+	void		AddDesc ( std::vector<IteratorDesc_t> & dDesc ) const final;
+
+	void		SetCutoff ( int iCutoff ) final	{ m_iRowsLeft = iCutoff; }
+	bool		WasCutoffHit() const final		{ return !m_iRowsLeft; }
+
+private:
+	struct Follower_t
+	{
+		std::unique_ptr<BlockIterator_i>	m_pIterator;
+		Span_T<uint32_t>	m_dRowIDs;
+		size_t				m_tPos = 0;
+		bool				m_bDone = false;
+	};
+
+	std::unique_ptr<BlockIterator_i>	m_pLead;
+	std::vector<Follower_t>				m_dFollowers;
+	std::vector<uint32_t>				m_dCollected;
+	int									m_iRowsLeft = INT_MAX;
+	bool								m_bDone = false;
+
+	FORCE_INLINE bool	Contains ( Follower_t & tFollower, uint32_t tRowID );
+};
+
+
+AndIterator_c::AndIterator_c ( const std::vector<BlockIterator_i *> & dIterators )
+{
+	assert ( dIterators.size()>1 );
+	m_pLead.reset ( dIterators[0] );
+
+	m_dFollowers.resize ( dIterators.size()-1 );
+	for ( size_t i = 1; i < dIterators.size(); i++ )
+		m_dFollowers[i-1].m_pIterator.reset ( dIterators[i] );
+}
+
+
+bool AndIterator_c::Contains ( Follower_t & tFollower, uint32_t tRowID )
+{
+	while ( !tFollower.m_bDone )
+	{
+		// rowids come in increasing order, so we never need to look back
+		auto & dRowIDs = tFollower.m_dRowIDs;
+		uint32_t * pFound = std::lower_bound ( dRowIDs.begin()+tFollower.m_tPos, dRowIDs.end(), tRowID );
+		tFollower.m_tPos = pFound-dRowIDs.begin();
+		if ( pFound!=dRowIDs.end() )
+			return *pFound==tRowID;
+
+		if ( !tFollower.m_pIterator->HintRowID(tRowID) || !tFollower.m_pIterator->GetNextRowIdBlock(dRowIDs) )
+		{
+			tFollower.m_bDone = true;
+			m_bDone = true;
+		}
+
+		tFollower.m_tPos = 0;
+	}
+
+	return false;
+}
+
+
+bool AndIterator_c::GetNextRowIdBlock ( Span_T<uint32_t> & dRowIdBlock )
+{
+	while ( !m_bDone && m_iRowsLeft>0 )
+	{
+		Span_T<uint32_t> dLead;
+		if ( !m_pLead->GetNextRowIdBlock(dLead) )
+			return false;
+
+		m_dCollected.resize(0);
+		for ( auto tRowID : dLead )
+		{
+			bool bMatch = true;
+			for ( auto & i : m_dFollowers )
+				if ( !Contains ( i, tRowID ) )
+				{
+					bMatch = false;
+					break;
+				}
+
+			if ( bMatch )
+				m_dCollected.push_back(tRowID);
+
+			if ( m_bDone )
+				break;
+		}
+
+		if ( m_dCollected.empty() )
+			continue;
+
+		if ( (int)m_dCollected.size()>m_iRowsLeft )
+			m_dCollected.resize(m_iRowsLeft);
+
+		m_iRowsLeft -= (int)m_dCollected.size();
+		dRowIdBlock = Span_T<uint32_t>(m_dCollected);
+		return true;
+	}
+
+	return false;
+}
+
+
+int64_t AndIterator_c::GetNumProcessed() const
+{
+	int64_t iProcessed = m_pLead->GetNumProcessed();
+	for ( const auto & i : m_dFollowers )
+		iProcessed += i.m_pIterator->GetNumProcessed();
+
+	return iProcessed;
+}
+
+
+void AndIterator_c::AddDesc ( std::vector<IteratorDesc_t> & dDesc ) const
+{
+	m_pLead->AddDesc(dDesc);
+	for ( const auto & i : m_dFollowers )
+		i.m_pIterator->AddDesc(dDesc);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// an attribute listed in the storage directory; its header is loaded on first use in lazy mode
+struct AttributeSlot_t
+{
+	std::string							m_sName;
+	AttrType_e							m_eType = AttrType_e::NONE;
+	int64_t								m_iHeaderOffset = 0;
+	int64_t								m_iBodyOffset = 0;
+	std::unique_ptr<AttributeHeader_i>	m_pHeader;
+	std::atomic<const AttributeHeader_i *> m_pLoaded { nullptr };	// published after m_pHeader is loaded
+	std::string							m_sLoadError;	// set if the lazy load failed; the load is not retried
+};
+
+// a filter that gets an analyzer; decided once per query, then instantiated for each set of matching blocks
+struct AnalyzerPlan_t
+{
+	int							m_iFilter = 0;
+	const AttributeHeader_i *	m_pHeader = nullptr;
+	bool						m_bRowIdRange = false;	// filter over a sorted attribute, resolved to [m_tMinRowID,m_tMaxRowID)
+	uint32_t					m_tMinRowID = 0;
+	uint32_t					m_tMaxRowID = 0;
+	int							m_iRank = 0;			// rough selectivity, lower first; fused analyzers are ordered by it
+};
+
+
 class Columnar_c final : public Columnar_i
 {
 public:
-										Columnar_c ( const std::string & sFilename, uint32_t uTotalDocs );
+										Columnar_c ( const std::string & sFilename, uint32_t uTotalDocs, uint64_t uSubblockCacheSize );
 
-	bool								Setup ( bool bMmap, std::string & sError );
+	bool								Setup ( bool bMmap, bool bLazyHeaders, std::string & sError );
 
 	Iterator_i *						CreateIterator ( const std::string & sName, const IteratorHints_t & tHints, columnar::IteratorCapabilities_t * pCapabilities, std::string & sError ) const final;
 	std::vector<BlockIterator_i *>		CreateAnalyzerOrPrefilter ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester ) const final;
+	std::vector<AnalyzerPartition_t>	CreatePartitionedAnalyzerOrPrefilter ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester, int iNumPartitions ) const final;
 	int64_t								EstimateMinMax ( const Filter_t & tFilter, const BlockTester_i & tBlockTester ) const final;
 	bool								GetAttrInfo ( const std::string & sName, AttrInfo_t & tInfo ) const final;
+	bool								Aggregate ( const std::vector<Filter_t> & dFilters, const std::vector<AggrSpec_t> & dAggrs, std::vector<AggrResult_t> & dResults, std::string & sError ) const final;
+	bool								TopK ( const std::string & sAttr, bool bDesc, int iK, BlockIterator_i * pRowIdFilter, std::vector<TopKMatch_t> & dResult, std::string & sError ) const final;
+	GroupCounter_i *					CreateGroupCounter ( const std::string & sName, std::string & sError ) const final;
+	ScanCursor_i *						CreateScanCursor ( const std::string & sName, uint32_t tMinRowID, uint32_t tMaxRowID, std::string & sError ) const final;
 
 	bool								EarlyReject ( const std::vector<Filter_t> & dFilters, const BlockTester_i & tBlockTester ) const final;
 	bool								IsFilterDegenerate ( const Filter_t & tFilter ) const final;
+	void								GetSubblockCacheStats ( SubblockCacheStats_t & tStats ) const final;
+	bool								PrefaultAttributes ( const std::vector<std::string> & dAttrs, const ResidencySettings_t & tSettings, std::string & sError ) const final;
+	void								GetAttributeStats ( std::vector<AttributeStats_t> & dStats ) const final;
 
 private:
 	std::string							m_sFilename;
 	uint32_t							m_uTotalDocs = 0;
 	uint32_t							m_uVersion = 0;
-	std::vector<std::unique_ptr<AttributeHeader_i>>	m_dHeaders;
-	std::unordered_map<std::string, HeaderWithLocator_t> m_hHeaders;
+	int64_t								m_iFileSize = 0;
+	int									m_iSubblockSize = 0;	// shared by all attributes; validated at Setup
+	std::vector<std::unique_ptr<AttributeSlot_t>>	m_dAttrs;
+	std::unordered_map<std::string, int>	m_hAttrs;		// name -> index in m_dAttrs
+	mutable std::mutex					m_tHeaderLock;		// serializes lazy header loads
 	FileReader_c						m_tReader;			// buffered; used for header loading + owns the shared fd
 	std::unique_ptr<MappedBuffer_i>		m_pMap;				// whole-.spc read-only mapping; non-null == mmap mode
+	std::unique_ptr<SubblockCache_c>	m_pSubblockCache;	// decoded integer subblocks shared by all accessors; null if disabled
 
 	const AttributeHeader_i *			GetHeader ( const std::string & sName ) const;
+	const AttributeHeader_i *			GetHeader ( const std::string & sName, std::string & sError ) const;
+	const AttributeHeader_i *			GetHeader ( int iAttr ) const;
+	const AttributeHeader_i *			GetHeader ( int iAttr, std::string & sError ) const;
+	std::pair<int64_t,int64_t>			GetAttributeBodyRange ( int iAttr ) const;
 	bool								LoadHeaders ( FileReader_c & tReader, int iNumAttrs, std::string & sError );
+	bool								LoadDirectory ( FileReader_c & tReader, int iNumAttrs, bool bLazyHeaders, std::string & sError );
+	bool								LoadHeader ( AttributeSlot_t & tAttr, FileReader_c & tReader, std::string & sError ) const;
+	bool								CheckDirectory ( int64_t iDirEnd, std::string & sError ) const;
 
 	bool								ShouldMmap() const	{ return !!m_pMap; }
 	template <typename RD> Iterator_i * CreateIteratorReader ( RD * pReader, const AttributeHeader_i & tHeader, const std::string & sName, const IteratorHints_t & tHints, columnar::IteratorCapabilities_t * pCapabilities, std::string & sError ) const;
+	template <typename RD> ScanCursor_i * CreateScanCursorReader ( RD * pReader, const AttributeHeader_i & tHeader, uint32_t tMinRowID, uint32_t tMaxRowID, std::string & sError ) const;
+	template <typename RD> GroupCounter_i * CreateGroupCounterReader ( RD * pReader, const AttributeHeader_i & tHeader, std::string & sError ) const;
 	template <typename RD> Analyzer_i * CreateAnalyzerReader ( RD * pReader, const AttributeHeader_i & tHeader, const Filter_t & tSettings, bool bHaveMatchingBlocks ) const;
 
 	HeaderWithLocator_t					GetHeaderForMinMax ( const Filter_t & tFilter ) const;
 	std::vector<HeaderWithLocator_t>	GetHeadersForMinMax ( const std::vector<Filter_t> & dFilters ) const;
+	const AttributeHeader_i *			GetHeaderForBloom ( const Filter_t & tFilter, std::vector<int64_t> & dValues ) const;
+	std::vector<uint8_t>				GetMatchingSubblocks ( const std::vector<Filter_t> & dFilters, std::vector<HeaderWithLocator_t> & dPruneHeaders ) const;
+	void								ApplyBloomFilters ( const std::vector<Filter_t> & dFilters, std::vector<uint8_t> & dMatching, std::vector<HeaderWithLocator_t> & dPruneHeaders ) const;
+	void								ApplyStrMinMax ( const std::vector<Filter_t> & dFilters, std::vector<uint8_t> & dMatching, std::vector<HeaderWithLocator_t> & dPruneHeaders ) const;
+	void								InitMatchingSubblocks ( std::vector<uint8_t> & dMatching ) const;
 
 	Analyzer_i *						CreateAnalyzer ( const Filter_t & tSettings, bool bHaveMatchingBlocks ) const;
+	bool								ResolveSortedRange ( const Filter_t & tFilter, const AttributeHeader_i & tHeader, uint32_t & tMinRowID, uint32_t & tMaxRowID ) const;
 	std::vector<BlockIterator_i *>		TryToCreatePrefilter ( const std::vector<HeaderWithLocator_t> & dHeaders, SharedBlocks_c pMatchingBlocks ) const;
-	std::vector<BlockIterator_i *>		TryToCreateAnalyzers ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, SharedBlocks_c & pMatchingBlocks ) const;
+	std::vector<AnalyzerPlan_t>			PlanAnalyzers ( const std::vector<Filter_t> & dFilters ) const;
+	std::vector<BlockIterator_i *>		CreateAnalyzers ( std::vector<AnalyzerPlan_t> & dPlan, const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, SharedBlocks_c & pMatchingBlocks ) const;
+	bool								CalcMatchingBlocks ( const std::vector<Filter_t> & dFilters, const BlockTester_i & tBlockTester, std::vector<HeaderWithLocator_t> & dHeaders, SharedBlocks_c & pMatchingBlocks ) const;
+	std::vector<BlockIterator_i *>		CreateIterators ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, std::vector<AnalyzerPlan_t> & dPlan, const std::vector<HeaderWithLocator_t> & dHeaders, SharedBlocks_c & pMatchingBlocks, bool bBlocksFiltered ) const;
+	BlockIterator_i *					FuseAnalyzers ( std::vector<BlockIterator_i *> & dAnalyzers, const std::vector<AnalyzerPlan_t> & dPlan ) const;
 };
 
 //////////////////////////////////////////////////////////////////////////
 
-Columnar_c::Columnar_c ( const std::string & sFilename, uint32_t uTotalDocs )
+Columnar_c::Columnar_c ( const std::string & sFilename, uint32_t uTotalDocs, uint64_t uSubblockCacheSize )
 	: m_sFilename ( sFilename )
 	, m_uTotalDocs ( uTotalDocs )
-{}
+{
+	if ( uSubblockCacheSize )
+		m_pSubblockCache = std::make_unique<SubblockCache_c>(uSubblockCacheSize);
+}
 
 
-bool Columnar_c::Setup ( bool bMmap, std::string & sError )
+bool Columnar_c::Setup ( bool bMmap, bool bLazyHeaders, std::string & sError )
 {
 	if ( !m_tReader.Open ( m_sFilename, sError ) )
 		return false;
 
+	m_iFileSize = m_tReader.GetFileSize();
 	m_uVersion = m_tReader.Read_uint32();
 	if ( StorageVersionWrong ( m_uVersion ) )
 	{
@@ -432,7 +1439,12 @@ bool Columnar_c::Setup ( bool bMmap, std::string & sError )
 	if ( !iNumAttrs )
 		return true;
 
-	if ( !LoadHeaders ( m_tReader, iNumAttrs, sError ) )
+	// older storages have no attribute directory; their headers are always loaded at once
+	bool bLoaded = m_uVersion>=16 ? LoadDirectory ( m_tReader, iNumAttrs, bLazyHeaders, sError ) : LoadHeaders ( m_tReader, iNumAttrs, sError );
+	if ( !bLoaded )
+		return false;
+
+	if ( !CheckSubblockSize ( m_iSubblockSize, sError ) )
 		return false;
 
 	if ( m_tReader.IsError() )
@@ -455,7 +1467,12 @@ bool Columnar_c::Setup ( bool bMmap, std::string & sError )
 
 Iterator_i * Columnar_c::CreateIterator ( const std::string & sName, const IteratorHints_t & tHints, columnar::IteratorCapabilities_t * pCapabilities, std::string & sError ) const
 {
-	const AttributeHeader_i * pHeader = GetHeader(sName);
+	// a missing attribute is not an error here; a header that failed to load is
+	const auto & tFound = m_hAttrs.find(sName);
+	if ( tFound==m_hAttrs.end() )
+		return nullptr;
+
+	const AttributeHeader_i * pHeader = GetHeader ( tFound->second, sError );
 	if ( !pHeader )
 		return nullptr;
 
@@ -467,7 +1484,95 @@ Iterator_i * Columnar_c::CreateIterator ( const std::string & sName, const Itera
 
 
 template <typename RD>
-Iterator_i * Columnar_c::CreateIteratorReader ( RD * pReader, const AttributeHeader_i & tHeader, const std::string & sName, const IteratorHints_t & tHints, columnar::IteratorCapabilities_t * pCapabilities, std::string & sError ) const
+Iterator_i * Columnar_c::CreateIteratorReader ( RD * pReader, const AttributeHeader_i & tHeader, const std::string & sName, const IteratorHints_t & tHints, columnar::IteratorCapabilities_t * pCapabilities, std::string & sError ) const
+{
+	std::unique_ptr<RD> pReaderPtr ( pReader );
+
+	switch ( tHeader.GetType() )
+	{
+	case AttrType_e::UINT32:
+	case AttrType_e::TIMESTAMP:
+	case AttrType_e::FLOAT:
+		return CreateIteratorUint32 ( tHeader, m_uVersion, m_pSubblockCache.get(), pReaderPtr.release() );
+
+	case AttrType_e::INT64:		return CreateIteratorUint64 ( tHeader, m_uVersion, m_pSubblockCache.get(), pReaderPtr.release() );
+	case AttrType_e::BOOLEAN:	return CreateIteratorBool ( tHeader, pReaderPtr.release() );
+	case AttrType_e::STRING:
+		if ( tHints.m_bNeedStringHashes )
+		{
+			const AttributeHeader_i * pHashHeader = GetHeader ( GenerateHashAttrName(sName) );
+			if ( pHashHeader )
+			{
+				if ( pCapabilities )
+					pCapabilities->m_bStringHashes = true;
+
+				return CreateIteratorUint64 ( *pHashHeader, m_uVersion, m_pSubblockCache.get(), pReaderPtr.release() );
+			}
+		}
+		return CreateIteratorStr ( tHeader, m_uVersion, pReaderPtr.release() );
+
+	case AttrType_e::UINT32SET:
+	case AttrType_e::INT64SET:
+	case AttrType_e::FLOATVEC:
+		return CreateIteratorMVA ( tHeader, m_uVersion, pReaderPtr.release(), tHints.m_bBuffered );
+
+	default:
+		sError = "Unsupported columnar iterator type";
+		return nullptr;
+	}
+}
+
+
+ScanCursor_i * Columnar_c::CreateScanCursor ( const std::string & sName, uint32_t tMinRowID, uint32_t tMaxRowID, std::string & sError ) const
+{
+	const AttributeHeader_i * pHeader = GetHeader ( sName, sError );
+	if ( !pHeader )
+		return nullptr;
+
+	if ( ShouldMmap() )
+		return CreateScanCursorReader ( new MappedReader_c ( (uint8_t*)m_pMap->GetPtr(), (int64_t)m_pMap->GetLengthBytes() ), *pHeader, tMinRowID, tMaxRowID, sError );
+
+	return CreateScanCursorReader ( new FileReader_c ( m_tReader.GetFD() ), *pHeader, tMinRowID, tMaxRowID, sError );
+}
+
+
+template <typename RD>
+ScanCursor_i * Columnar_c::CreateScanCursorReader ( RD * pReader, const AttributeHeader_i & tHeader, uint32_t tMinRowID, uint32_t tMaxRowID, std::string & sError ) const
+{
+	std::unique_ptr<RD> pReaderPtr ( pReader );
+
+	switch ( tHeader.GetType() )
+	{
+	case AttrType_e::UINT32:
+	case AttrType_e::TIMESTAMP:
+	case AttrType_e::FLOAT:
+		return CreateScanCursorUint32 ( tHeader, m_uVersion, m_pSubblockCache.get(), pReaderPtr.release(), tMinRowID, tMaxRowID );
+
+	case AttrType_e::INT64:		return CreateScanCursorUint64 ( tHeader, m_uVersion, m_pSubblockCache.get(), pReaderPtr.release(), tMinRowID, tMaxRowID );
+	case AttrType_e::BOOLEAN:	return CreateScanCursorBool ( tHeader, pReaderPtr.release(), tMinRowID, tMaxRowID );
+
+	default:
+		sError = "Unsupported columnar scan cursor type";
+		return nullptr;
+	}
+}
+
+
+GroupCounter_i * Columnar_c::CreateGroupCounter ( const std::string & sName, std::string & sError ) const
+{
+	const AttributeHeader_i * pHeader = GetHeader ( sName, sError );
+	if ( !pHeader )
+		return nullptr;
+
+	if ( ShouldMmap() )
+		return CreateGroupCounterReader ( new MappedReader_c ( (uint8_t*)m_pMap->GetPtr(), (int64_t)m_pMap->GetLengthBytes() ), *pHeader, sError );
+
+	return CreateGroupCounterReader ( new FileReader_c ( m_tReader.GetFD() ), *pHeader, sError );
+}
+
+
+template <typename RD>
+GroupCounter_i * Columnar_c::CreateGroupCounterReader ( RD * pReader, const AttributeHeader_i & tHeader, std::string & sError ) const
 {
 	std::unique_ptr<RD> pReaderPtr ( pReader );
 
@@ -476,31 +1581,17 @@ Iterator_i * Columnar_c::CreateIteratorReader ( RD * pReader, const AttributeHea
 	case AttrType_e::UINT32:
 	case AttrType_e::TIMESTAMP:
 	case AttrType_e::FLOAT:
-		return CreateIteratorUint32 ( tHeader, m_uVersion, pReaderPtr.release() );
-
-	case AttrType_e::INT64:		return CreateIteratorUint64 ( tHeader, m_uVersion, pReaderPtr.release() );
-	case AttrType_e::BOOLEAN:	return CreateIteratorBool ( tHeader, pReaderPtr.release() );
-	case AttrType_e::STRING:
-		if ( tHints.m_bNeedStringHashes )
-		{
-			const AttributeHeader_i * pHashHeader = GetHeader ( GenerateHashAttrName(sName) );
-			if ( pHashHeader )
-			{
-				if ( pCapabilities )
-					pCapabilities->m_bStringHashes = true;
+		return CreateGroupCounterUint32 ( tHeader, m_uVersion, m_pSubblockCache.get(), pReaderPtr.release() );
 
-				return CreateIteratorUint64 ( *pHashHeader, m_uVersion, pReaderPtr.release() );
-			}
-		}
-		return CreateIteratorStr ( tHeader, m_uVersion, pReaderPtr.release() );
+	case AttrType_e::INT64:		return CreateGroupCounterUint64 ( tHeader, m_uVersion, m_pSubblockCache.get(), pReaderPtr.release() );
+	case AttrType_e::STRING:	return CreateGroupCounterStr ( tHeader, m_uVersion, pReaderPtr.release() );
 
 	case AttrType_e::UINT32SET:
 	case AttrType_e::INT64SET:
-	case AttrType_e::FLOATVEC:
-		return CreateIteratorMVA ( tHeader, m_uVersion, pReaderPtr.release(), tHints.m_bBuffered );
+		return CreateGroupCounterMVA ( tHeader, m_uVersion, pReaderPtr.release() );
 
 	default:
-		sError = "Unsupported columnar iterator type";
+		sError = "Unsupported columnar group counter type";
 		return nullptr;
 	}
 }
@@ -534,7 +1625,7 @@ Analyzer_i * Columnar_c::CreateAnalyzerReader ( RD * pReader, const AttributeHea
 	{
 		Filter_t tFixedSettings = tSettings;
 		FixupFilterSettings ( tFixedSettings, eType );
-		return CreateAnalyzerInt ( tHeader, m_uVersion, pReaderPtr.release(), tFixedSettings, bHaveMatchingBlocks );
+		return CreateAnalyzerInt ( tHeader, m_uVersion, m_pSubblockCache.get(), pReaderPtr.release(), tFixedSettings, bHaveMatchingBlocks );
 	}
 
 	case AttrType_e::BOOLEAN:
@@ -545,11 +1636,11 @@ Analyzer_i * Columnar_c::CreateAnalyzerReader ( RD * pReader, const AttributeHea
 		return CreateAnalyzerMVA ( tHeader, m_uVersion, pReaderPtr.release(), tSettings, bHaveMatchingBlocks );
 
 	case AttrType_e::STRING:
-		if ( tSettings.m_fnCalcStrHash )
+		if ( tSettings.m_eType==FilterType_e::STRINGS && tSettings.m_fnCalcStrHash )
 		{
 			const AttributeHeader_i * pHashHeader = GetHeader ( GenerateHashAttrName ( tSettings.m_sName ) );
 			if ( pHashHeader )
-				return CreateAnalyzerInt ( *pHashHeader, m_uVersion, pReaderPtr.release(), StringFilterToHashFilter ( tSettings, true ), bHaveMatchingBlocks );
+				return CreateAnalyzerInt ( *pHashHeader, m_uVersion, m_pSubblockCache.get(), pReaderPtr.release(), StringFilterToHashFilter ( tSettings, true ), bHaveMatchingBlocks );
 		}
 
 		return CreateAnalyzerStr ( tHeader, m_uVersion, pReaderPtr.release(), tSettings, bHaveMatchingBlocks );
@@ -595,6 +1686,172 @@ std::vector<HeaderWithLocator_t> Columnar_c::GetHeadersForMinMax ( const std::ve
 }
 
 
+const AttributeHeader_i * Columnar_c::GetHeaderForBloom ( const Filter_t & tFilter, std::vector<int64_t> & dValues ) const
+{
+	if ( tFilter.m_bExclude )
+		return nullptr;
+
+	const AttributeHeader_i * pHeader = nullptr;
+	switch ( tFilter.m_eType )
+	{
+	case FilterType_e::VALUES:
+		pHeader = GetHeader ( tFilter.m_sName );
+		dValues = tFilter.m_dValues;
+		break;
+
+	case FilterType_e::STRINGS:
+		// strings are checked against the bloom filters of their hash attribute
+		if ( tFilter.m_fnCalcStrHash )
+		{
+			Filter_t tHashFilter = StringFilterToHashFilter ( tFilter, true );
+			pHeader = GetHeader ( tHashFilter.m_sName );
+			dValues = tHashFilter.m_dValues;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	if ( !pHeader || !pHeader->HaveBloomFilters() )
+		return nullptr;
+
+	return pHeader;
+}
+
+
+void Columnar_c::InitMatchingSubblocks ( std::vector<uint8_t> & dMatching ) const
+{
+	if ( !dMatching.empty() )
+		return;
+
+	dMatching.resize ( ( m_uTotalDocs + m_iSubblockSize - 1 ) / m_iSubblockSize, 1 );
+}
+
+
+void Columnar_c::ApplyBloomFilters ( const std::vector<Filter_t> & dFilters, std::vector<uint8_t> & dMatching, std::vector<HeaderWithLocator_t> & dPruneHeaders ) const
+{
+	std::vector<int64_t> dValues;
+	for ( const auto & i : dFilters )
+	{
+		const AttributeHeader_i * pHeader = GetHeaderForBloom ( i, dValues );
+		if ( !pHeader )
+			continue;
+
+		InitMatchingSubblocks(dMatching);
+
+		int iSubblocksPerBlock = DOCS_PER_BLOCK / pHeader->GetSettings().m_iSubblockSize;
+		int iTotalSubblocks = (int)dMatching.size();
+		for ( int iBlock = 0; iBlock < pHeader->GetNumBlocks(); iBlock++ )
+		{
+			if ( std::any_of ( dValues.begin(), dValues.end(), [pHeader, iBlock]( int64_t iValue ){ return pHeader->BloomMayContain ( iBlock, (uint64_t)iValue ); } ) )
+				continue;
+
+			int iStart = iBlock*iSubblocksPerBlock;
+			int iEnd = std::min ( iStart+iSubblocksPerBlock, iTotalSubblocks );
+			std::fill ( dMatching.begin()+iStart, dMatching.begin()+iEnd, 0 );
+		}
+
+		dPruneHeaders.push_back ( { pHeader, 0 } );
+	}
+}
+
+
+static bool GetStrKeyRanges ( const Filter_t & tFilter, std::vector<std::pair<uint64_t,uint64_t>> & dRanges )
+{
+	// STRINGS filters compare using collations; only bytewise filters map onto prefix keys
+	if ( tFilter.m_eType!=FilterType_e::PREFIX || tFilter.m_bExclude )
+		return false;
+
+	dRanges.resize(0);
+	for ( const auto & i : tFilter.m_dStringValues )
+	{
+		uint64_t uMin = StringPrefixKey ( i.data(), (int)i.size() );
+		uint64_t uMax = i.size()>=sizeof(uint64_t) ? uMin : uMin | ( UINT64_MAX >> ( i.size()*8 ) );
+		dRanges.push_back ( { uMin, uMax } );
+	}
+
+	return !dRanges.empty();
+}
+
+
+static void EvalStrMinMax ( const AttributeHeader_i & tHeader, const std::vector<std::pair<uint64_t,uint64_t>> & dRanges, int iLevel, int iBlock, std::vector<uint8_t> & dPassed )
+{
+	if ( iBlock>=tHeader.GetNumMinMaxBlocks(iLevel) )
+		return;
+
+	auto tMinMax = tHeader.GetStrMinMax ( iLevel, iBlock );
+	if ( std::none_of ( dRanges.begin(), dRanges.end(), [&tMinMax]( const auto & tRange ){ return tRange.first<=tMinMax.second && tRange.second>=tMinMax.first; } ) )
+		return;
+
+	if ( iLevel==tHeader.GetNumMinMaxLevels()-1 )
+	{
+		dPassed[iBlock] = 1;
+		return;
+	}
+
+	EvalStrMinMax ( tHeader, dRanges, iLevel+1, iBlock<<1, dPassed );
+	EvalStrMinMax ( tHeader, dRanges, iLevel+1, (iBlock<<1)+1, dPassed );
+}
+
+
+void Columnar_c::ApplyStrMinMax ( const std::vector<Filter_t> & dFilters, std::vector<uint8_t> & dMatching, std::vector<HeaderWithLocator_t> & dPruneHeaders ) const
+{
+	std::vector<std::pair<uint64_t,uint64_t>> dRanges;
+	std::vector<uint8_t> dPassed;
+	for ( const auto & i : dFilters )
+	{
+		const AttributeHeader_i * pHeader = GetHeader ( i.m_sName );
+		if ( !pHeader || !pHeader->HaveStrMinMax() || !pHeader->GetNumMinMaxLevels() || !GetStrKeyRanges ( i, dRanges ) )
+			continue;
+
+		InitMatchingSubblocks(dMatching);
+		dPassed.resize(0);
+		dPassed.resize ( dMatching.size(), 0 );
+		EvalStrMinMax ( *pHeader, dRanges, 0, 0, dPassed );
+
+		for ( size_t iSubblock = 0; iSubblock < dMatching.size(); iSubblock++ )
+			dMatching[iSubblock] &= dPassed[iSubblock];
+
+		dPruneHeaders.push_back ( { pHeader, 0 } );
+	}
+}
+
+
+std::vector<uint8_t> Columnar_c::GetMatchingSubblocks ( const std::vector<Filter_t> & dFilters, std::vector<HeaderWithLocator_t> & dPruneHeaders ) const
+{
+	// empty result means that no filters could be checked this way
+	std::vector<uint8_t> dMatching;
+	ApplyBloomFilters ( dFilters, dMatching, dPruneHeaders );
+	ApplyStrMinMax ( dFilters, dMatching, dPruneHeaders );
+	return dMatching;
+}
+
+
+static SharedBlocks_c FilterMatchingBlocks ( const MatchingBlocks_c * pBlocks, const std::vector<uint8_t> & dMatching )
+{
+	SharedBlocks_c pResult ( new MatchingBlocks_c );
+
+	if ( pBlocks )
+	{
+		for ( int i = 0; i < pBlocks->GetNumBlocks(); i++ )
+		{
+			int iSubblock = pBlocks->GetBlock(i);
+			if ( dMatching[iSubblock] )
+				pResult->Add(iSubblock);
+		}
+
+		return pResult;
+	}
+
+	for ( size_t i = 0; i < dMatching.size(); i++ )
+		if ( dMatching[i] )
+			pResult->Add ( (int)i );
+
+	return pResult;
+}
+
+
 static void FetchRowIdLimits ( const Filter_t & tFilter, uint32_t uNumDocs, uint32_t & uMinRowID, uint32_t & uMaxRowID )
 {
 	uint32_t uMin = (uint32_t)tFilter.m_iMinValue;
@@ -614,10 +1871,10 @@ static void PopulateMatchingBlocks ( MatchingBlocks_c & tBlocks, int iBlockSize,
 }
 
 
-std::vector<BlockIterator_i *> Columnar_c::CreateAnalyzerOrPrefilter ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester ) const
+bool Columnar_c::CalcMatchingBlocks ( const std::vector<Filter_t> & dFilters, const BlockTester_i & tBlockTester, std::vector<HeaderWithLocator_t> & dHeaders, SharedBlocks_c & pMatchingBlocks ) const
 {
-	std::vector<HeaderWithLocator_t> dHeaders = GetHeadersForMinMax(dFilters);
-	SharedBlocks_c pMatchingBlocks ( dHeaders.empty() ? nullptr : new MatchingBlocks_c );
+	dHeaders = GetHeadersForMinMax(dFilters);
+	pMatchingBlocks = SharedBlocks_c ( dHeaders.empty() ? nullptr : new MatchingBlocks_c );
 
 	const Filter_t * pRowIdFilter = nullptr;
 	for ( auto & i : dFilters )
@@ -627,13 +1884,18 @@ std::vector<BlockIterator_i *> Columnar_c::CreateAnalyzerOrPrefilter ( const std
 			break;
 		}
 
-	uint32_t uNumDocs = m_dHeaders[0]->GetNumDocs();
+	uint32_t uNumDocs = m_uTotalDocs;
 	uint32_t uMinRowID = 0;
 	uint32_t uMaxRowID = INVALID_ROW_ID;
 	if ( pRowIdFilter )
 		FetchRowIdLimits ( *pRowIdFilter, uNumDocs, uMinRowID, uMaxRowID );
 
-	int iSubblockSize = m_dHeaders[0]->GetSettings().m_iSubblockSize;
+	std::vector<HeaderWithLocator_t> dPruneHeaders;
+	std::vector<uint8_t> dMatchingSubblocks = GetMatchingSubblocks ( dFilters, dPruneHeaders );
+	bool bPruned = !dMatchingSubblocks.empty();
+
+	int iSubblockSize = m_iSubblockSize;
+	int iTotalBlocks = ( uNumDocs + iSubblockSize - 1 ) / iSubblockSize;
 	bool bMinMaxBlocks = !!pMatchingBlocks;
 	if ( bMinMaxBlocks )
 	{
@@ -642,82 +1904,364 @@ std::vector<BlockIterator_i *> Columnar_c::CreateAnalyzerOrPrefilter ( const std
 			MinMaxEval_T<true,false> tMinMaxEval ( dHeaders, tBlockTester, pMatchingBlocks, uMinRowID, uMaxRowID );
 			tMinMaxEval.Eval();
 		}
-		else
+		else
+		{
+			MinMaxEval_T<false,false> tMinMaxEval ( dHeaders, tBlockTester, pMatchingBlocks, uMinRowID, uMaxRowID );
+			tMinMaxEval.Eval();
+		}
+
+		if ( bPruned )
+			pMatchingBlocks = FilterMatchingBlocks ( pMatchingBlocks.get(), dMatchingSubblocks );
+
+		if ( iTotalBlocks==pMatchingBlocks->GetNumBlocks() )
+			pMatchingBlocks = nullptr;
+	}
+	else if ( pRowIdFilter )
+	{
+		pMatchingBlocks = SharedBlocks_c ( new MatchingBlocks_c );
+		PopulateMatchingBlocks ( *pMatchingBlocks, iSubblockSize, uMinRowID, uMaxRowID );
+
+		if ( bPruned )
+			pMatchingBlocks = FilterMatchingBlocks ( pMatchingBlocks.get(), dMatchingSubblocks );
+	}
+	else if ( bPruned )
+	{
+		pMatchingBlocks = FilterMatchingBlocks ( nullptr, dMatchingSubblocks );
+		if ( iTotalBlocks==pMatchingBlocks->GetNumBlocks() )
+			pMatchingBlocks = nullptr;
+	}
+
+	// prefilters also check the attributes used for pruning
+	for ( const auto & i : dPruneHeaders )
+		if ( std::none_of ( dHeaders.begin(), dHeaders.end(), [&i]( const auto & tHeader ){ return tHeader.first==i.first; } ) )
+			dHeaders.push_back(i);
+
+	if ( pMatchingBlocks )
+	{
+		int iSkipped = iTotalBlocks - pMatchingBlocks->GetNumBlocks();
+		if ( iSkipped>0 )
+			for ( const auto & i : dHeaders )
+				i.first->GetCounters().m_iSubblocksSkipped.fetch_add ( iSkipped, std::memory_order_relaxed );
+	}
+
+	return bMinMaxBlocks || bPruned;
+}
+
+
+std::vector<BlockIterator_i *> Columnar_c::CreateIterators ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, std::vector<AnalyzerPlan_t> & dPlan, const std::vector<HeaderWithLocator_t> & dHeaders, SharedBlocks_c & pMatchingBlocks, bool bBlocksFiltered ) const
+{
+	std::vector<BlockIterator_i *> dAnalyzers = CreateAnalyzers ( dPlan, dFilters, dDeletedFilters, pMatchingBlocks );
+	if ( dAnalyzers.size()>1 )
+		return { FuseAnalyzers ( dAnalyzers, dPlan ) };
+
+	if ( !dAnalyzers.empty() )
+		return dAnalyzers;
+
+	if ( !bBlocksFiltered )
+		return {};
+
+	return TryToCreatePrefilter ( dHeaders, pMatchingBlocks );
+}
+
+
+std::vector<BlockIterator_i *> Columnar_c::CreateAnalyzerOrPrefilter ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester ) const
+{
+	std::vector<HeaderWithLocator_t> dHeaders;
+	SharedBlocks_c pMatchingBlocks;
+	bool bBlocksFiltered = CalcMatchingBlocks ( dFilters, tBlockTester, dHeaders, pMatchingBlocks );
+	std::vector<AnalyzerPlan_t> dPlan = PlanAnalyzers(dFilters);
+	return CreateIterators ( dFilters, dDeletedFilters, dPlan, dHeaders, pMatchingBlocks, bBlocksFiltered );
+}
+
+
+static SharedBlocks_c SliceMatchingBlocks ( const MatchingBlocks_c * pBlocks, int iStart, int iEnd )
+{
+	SharedBlocks_c pResult ( new MatchingBlocks_c );
+	if ( !pBlocks )
+	{
+		for ( int i = iStart; i < iEnd; i++ )
+			pResult->Add(i);
+
+		return pResult;
+	}
+
+	int iNumBlocks = pBlocks->GetNumBlocks();
+	for ( int i = pBlocks->Find ( 0, iStart ); i < iNumBlocks && pBlocks->GetBlock(i) < iEnd; i++ )
+		pResult->Add ( pBlocks->GetBlock(i) );
+
+	return pResult;
+}
+
+
+std::vector<AnalyzerPartition_t> Columnar_c::CreatePartitionedAnalyzerOrPrefilter ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester, int iNumPartitions ) const
+{
+	if ( m_dAttrs.empty() )
+		return {};
+
+	std::vector<HeaderWithLocator_t> dHeaders;
+	SharedBlocks_c pMatchingBlocks;
+	bool bBlocksFiltered = CalcMatchingBlocks ( dFilters, tBlockTester, dHeaders, pMatchingBlocks );
+
+	uint32_t uNumDocs = m_uTotalDocs;
+	int iSubblockSize = m_iSubblockSize;
+
+	// nothing can match; an empty result would mean "no analyzers, scan everything"
+	if ( pMatchingBlocks && !pMatchingBlocks->GetNumBlocks() )
+	{
+		AnalyzerPartition_t tEmpty;
+		tEmpty.m_dIterators.push_back ( new RowIdRangeIterator_c ( dFilters.front().m_sName, 0, 0, iSubblockSize, pMatchingBlocks ) );
+		return { tEmpty };
+	}
+
+	// analyzer decisions (and sorted range lookups) don't depend on the partition
+	std::vector<AnalyzerPlan_t> dPlan = PlanAnalyzers(dFilters);
+	if ( dPlan.empty() && !bBlocksFiltered )
+		return {};
+
+	int iSubblocksPerBlock = DOCS_PER_BLOCK / iSubblockSize;
+	int iTotalSubblocks = ( uNumDocs + iSubblockSize - 1 ) / iSubblockSize;
+	int iTotalBlocks = ( uNumDocs + DOCS_PER_BLOCK - 1 ) / DOCS_PER_BLOCK;
+	iNumPartitions = std::max ( std::min ( iNumPartitions, iTotalBlocks ), 1 );
+
+	std::vector<AnalyzerPartition_t> dPartitions;
+	std::vector<int> dDeleted;
+	for ( int iPartition = 0; iPartition < iNumPartitions; iPartition++ )
+	{
+		int iFirstBlock = int ( (int64_t)iTotalBlocks*iPartition/iNumPartitions );
+		int iLastBlock = int ( (int64_t)iTotalBlocks*(iPartition+1)/iNumPartitions );
+
+		// each partition gets its own slice of matching subblocks, so even unfiltered scans stay within the partition
+		SharedBlocks_c pSlice = SliceMatchingBlocks ( pMatchingBlocks.get(), iFirstBlock*iSubblocksPerBlock, std::min ( iLastBlock*iSubblocksPerBlock, iTotalSubblocks ) );
+		if ( !pSlice->GetNumBlocks() )
+			continue;
+
+		dDeleted.resize(0);
+		std::vector<BlockIterator_i *> dIterators = CreateIterators ( dFilters, dDeleted, dPlan, dHeaders, pSlice, bBlocksFiltered );
+		if ( dIterators.empty() )
+		{
+			// no analyzers and nothing to prefilter (same for every partition); let the caller do a plain scan
+			assert ( dPartitions.empty() );
+			return {};
+		}
+
+		AnalyzerPartition_t & tPartition = dPartitions.emplace_back();
+		tPartition.m_tMinRowID = uint32_t(iFirstBlock)*DOCS_PER_BLOCK;
+		tPartition.m_tMaxRowID = std::min ( uint32_t(iLastBlock)*DOCS_PER_BLOCK, uNumDocs );
+		tPartition.m_dIterators = std::move(dIterators);
+	}
+
+	// all partitions create analyzers for the same filters
+	dDeletedFilters.insert ( dDeletedFilters.end(), dDeleted.begin(), dDeleted.end() );
+	return dPartitions;
+}
+
+
+int64_t Columnar_c::EstimateMinMax ( const Filter_t & tFilter, const BlockTester_i & tBlockTester ) const
+{
+	HeaderWithLocator_t tHeader = GetHeaderForMinMax(tFilter);
+	if ( !tHeader.first )
+		return -1;
+
+	std::vector<HeaderWithLocator_t> dHeaders;
+	dHeaders.push_back(tHeader);
+
+	int iNumLevels = tHeader.first->GetNumMinMaxLevels();
+	int iStopAtLevel = std::max ( 0, iNumLevels-1 );
+	int iReducedSubblockSize = tHeader.first->GetSettings().m_iSubblockSize;
+
+	const int MIN_REDUCE_LEVELS = 8;
+	const int REDUCE_STEP = 3;
+	if ( iNumLevels>=MIN_REDUCE_LEVELS )
+	{
+		iStopAtLevel -= REDUCE_STEP;
+		iReducedSubblockSize <<= REDUCE_STEP;
+	}
+
+	SharedBlocks_c pShared(nullptr);
+	MinMaxEval_T<false,true> tMinMaxEval ( dHeaders, tBlockTester, pShared, 0, INVALID_ROW_ID, iStopAtLevel );
+	tMinMaxEval.Eval();
+	
+	return int64_t(tMinMaxEval.GetNumMatchedBlocks())*iReducedSubblockSize;
+}
+
+
+bool Columnar_c::GetAttrInfo ( const std::string & sName, AttrInfo_t & tInfo ) const
+{
+	const auto & tFound = m_hAttrs.find(sName);
+	if ( tFound==m_hAttrs.end() )
+		return false;
+
+	const AttributeHeader_i * pHeader = GetHeader ( tFound->second );
+	if ( !pHeader )
+		return false;
+
+	tInfo.m_iId = tFound->second;
+	tInfo.m_eType = pHeader->GetType();
+
+	const AttributeHeader_i * pHashHeader = GetHeader ( GenerateHashAttrName(sName) );
+	tInfo.m_fComplexity = pHashHeader ? pHashHeader->GetComplexity() : pHeader->GetComplexity();
+	tInfo.m_bStablePtr = ShouldMmap();
+
+	return true;
+}
+
+
+static bool IsAggregateType ( AttrType_e eType )
+{
+	switch ( eType )
+	{
+	case AttrType_e::UINT32:
+	case AttrType_e::TIMESTAMP:
+	case AttrType_e::INT64:
+	case AttrType_e::FLOAT:
+	case AttrType_e::BOOLEAN:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+
+bool Columnar_c::Aggregate ( const std::vector<Filter_t> & dFilters, const std::vector<AggrSpec_t> & dAggrs, std::vector<AggrResult_t> & dResults, std::string & sError ) const
+{
+	if ( m_dAttrs.empty() )
+	{
+		sError = "No columnar attributes";
+		return false;
+	}
+
+	std::vector<AggrFilter_t> dAggrFilters;
+	for ( const auto & i : dFilters )
+	{
+		const AttributeHeader_i * pHeader = GetHeader ( i.m_sName );
+		if ( !pHeader || !IsAggregateType ( pHeader->GetType() ) )
+		{
+			sError = FormatStr ( "Unable to aggregate using filter on '%s'", i.m_sName.c_str() );
+			return false;
+		}
+
+		Filter_t tFixedFilter = i;
+		FixupFilterSettings ( tFixedFilter, pHeader->GetType() );
+
+		bool bFloat = pHeader->GetType()==AttrType_e::FLOAT;
+		bool bSupported = bFloat ? tFixedFilter.m_eType==FilterType_e::FLOATRANGE : ( tFixedFilter.m_eType==FilterType_e::VALUES || tFixedFilter.m_eType==FilterType_e::RANGE );
+		bSupported &= !tFixedFilter.m_bExclude || tFixedFilter.m_eType==FilterType_e::VALUES;
+		if ( !bSupported )
+		{
+			sError = FormatStr ( "Unsupported filter type on '%s'", i.m_sName.c_str() );
+			return false;
+		}
+
+		dAggrFilters.push_back ( { pHeader, std::make_unique<FilterEval_c>(tFixedFilter), nullptr } );
+		dAggrFilters.back().m_pCursor.reset ( CreateScanCursor ( i.m_sName, 0, 0, sError ) );
+		if ( !dAggrFilters.back().m_pCursor )
+			return false;
+	}
+
+	std::vector<AggrAttr_t> dAggrAttrs;
+	for ( const auto & i : dAggrs )
+	{
+		dAggrAttrs.push_back ( { i.m_eFunc, nullptr, false, nullptr } );
+		if ( i.m_eFunc==AggrFunc_e::COUNT )
+			continue;
+
+		const AttributeHeader_i * pHeader = GetHeader ( i.m_sAttr );
+		if ( !pHeader || !IsAggregateType ( pHeader->GetType() ) )
 		{
-			MinMaxEval_T<false,false> tMinMaxEval ( dHeaders, tBlockTester, pMatchingBlocks, uMinRowID, uMaxRowID );
-			tMinMaxEval.Eval();
+			sError = FormatStr ( "Unable to aggregate '%s'", i.m_sAttr.c_str() );
+			return false;
 		}
 
-		int iTotalBlocks = ( uNumDocs + iSubblockSize - 1 ) / iSubblockSize;
-		if ( iTotalBlocks==pMatchingBlocks->GetNumBlocks() )
-			pMatchingBlocks = nullptr;
+		auto & tAttr = dAggrAttrs.back();
+		tAttr.m_pHeader = pHeader;
+		tAttr.m_bFloat = pHeader->GetType()==AttrType_e::FLOAT;
+		tAttr.m_pCursor.reset ( CreateScanCursor ( i.m_sAttr, 0, 0, sError ) );
+		if ( !tAttr.m_pCursor )
+			return false;
 	}
-	else if ( pRowIdFilter )
+
+	// all attributes share the same min-max tree layout; prefer the headers that are already loaded
+	const AttributeHeader_i * pTreeHeader = nullptr;
+	for ( const auto & i : dAggrFilters )
+		if ( !pTreeHeader && i.m_pHeader->GetNumMinMaxLevels() )
+			pTreeHeader = i.m_pHeader;
+
+	for ( const auto & i : dAggrAttrs )
+		if ( !pTreeHeader && i.m_pHeader && i.m_pHeader->GetNumMinMaxLevels() )
+			pTreeHeader = i.m_pHeader;
+
+	for ( int i = 0; i < (int)m_dAttrs.size() && !pTreeHeader; i++ )
 	{
-		pMatchingBlocks = SharedBlocks_c ( new MatchingBlocks_c );
-		PopulateMatchingBlocks ( *pMatchingBlocks, iSubblockSize, uMinRowID, uMaxRowID );
+		const AttributeHeader_i * pHeader = GetHeader(i);
+		if ( pHeader && pHeader->GetNumMinMaxLevels() )
+			pTreeHeader = pHeader;
 	}
 
-	std::vector<BlockIterator_i *> dAnalyzers = TryToCreateAnalyzers ( dFilters, dDeletedFilters, pMatchingBlocks );
-	if ( !dAnalyzers.empty() )
-		return dAnalyzers;
+	if ( !pTreeHeader )
+		pTreeHeader = GetHeader ( 0, sError );
 
-	if ( !bMinMaxBlocks )
-		return {};
+	if ( !pTreeHeader )
+		return false;
 
-	return TryToCreatePrefilter ( dHeaders, pMatchingBlocks );
+	Aggregator_c tAggregator ( dAggrFilters, dAggrAttrs, *pTreeHeader, dResults );
+	tAggregator.Aggregate();
+	return true;
 }
 
 
-int64_t Columnar_c::EstimateMinMax ( const Filter_t & tFilter, const BlockTester_i & tBlockTester ) const
+bool Columnar_c::TopK ( const std::string & sAttr, bool bDesc, int iK, BlockIterator_i * pRowIdFilter, std::vector<TopKMatch_t> & dResult, std::string & sError ) const
 {
-	HeaderWithLocator_t tHeader = GetHeaderForMinMax(tFilter);
-	if ( !tHeader.first )
-		return -1;
-
-	std::vector<HeaderWithLocator_t> dHeaders;
-	dHeaders.push_back(tHeader);
+	dResult.resize(0);
 
-	int iNumLevels = tHeader.first->GetNumMinMaxLevels();
-	int iStopAtLevel = std::max ( 0, iNumLevels-1 );
-	int iReducedSubblockSize = tHeader.first->GetSettings().m_iSubblockSize;
+	const AttributeHeader_i * pHeader = GetHeader ( sAttr, sError );
+	if ( !pHeader )
+		return false;
 
-	const int MIN_REDUCE_LEVELS = 8;
-	const int REDUCE_STEP = 3;
-	if ( iNumLevels>=MIN_REDUCE_LEVELS )
+	auto eType = pHeader->GetType();
+	if ( eType!=AttrType_e::UINT32 && eType!=AttrType_e::TIMESTAMP && eType!=AttrType_e::INT64 && eType!=AttrType_e::FLOAT )
 	{
-		iStopAtLevel -= REDUCE_STEP;
-		iReducedSubblockSize <<= REDUCE_STEP;
+		sError = FormatStr ( "Unable to find top rows by '%s'", sAttr.c_str() );
+		return false;
 	}
 
-	SharedBlocks_c pShared(nullptr);
-	MinMaxEval_T<false,true> tMinMaxEval ( dHeaders, tBlockTester, pShared, 0, INVALID_ROW_ID, iStopAtLevel );
-	tMinMaxEval.Eval();
-	
-	return int64_t(tMinMaxEval.GetNumMatchedBlocks())*iReducedSubblockSize;
+	std::unique_ptr<ScanCursor_i> pCursor ( CreateScanCursor ( sAttr, 0, 0, sError ) );
+	if ( !pCursor )
+		return false;
+
+	TopK_c tTopK ( *pHeader, *pCursor, bDesc, iK );
+	if ( pRowIdFilter )
+		tTopK.SetRowIdFilter ( *pRowIdFilter );
+
+	tTopK.Find();
+	tTopK.GetResult(dResult);
+	return true;
 }
 
 
-bool Columnar_c::GetAttrInfo ( const std::string & sName, AttrInfo_t & tInfo ) const
+BlockIterator_i * Columnar_c::FuseAnalyzers ( std::vector<BlockIterator_i *> & dAnalyzers, const std::vector<AnalyzerPlan_t> & dPlan ) const
 {
-	const auto & tFound = m_hHeaders.find(sName);
-	if ( tFound==m_hHeaders.end() )
-		return false;
-	
-	tInfo.m_iId = tFound->second.second;
-	tInfo.m_eType = tFound->second.first->GetType();
+	assert ( dAnalyzers.size()==dPlan.size() );
+	std::vector<std::pair<int,BlockIterator_i *>> dSorted;
+	for ( size_t i = 0; i < dAnalyzers.size(); i++ )
+		dSorted.push_back ( { dPlan[i].m_iRank, dAnalyzers[i] } );
 
-	const auto & tHashFound = m_hHeaders.find ( GenerateHashAttrName(sName) );
-	bool bHasHash = tHashFound!=m_hHeaders.end();
-	tInfo.m_fComplexity = bHasHash ? tHashFound->second.first->GetComplexity() : tFound->second.first->GetComplexity();
-	tInfo.m_bStablePtr = ShouldMmap();
+	std::stable_sort ( dSorted.begin(), dSorted.end(), []( const auto & tA, const auto & tB ){ return tA.first<tB.first; } );
 
-	return true;
+	for ( size_t i = 0; i < dSorted.size(); i++ )
+		dAnalyzers[i] = dSorted[i].second;
+
+	return new AndIterator_c(dAnalyzers);
 }
 
 
 bool Columnar_c::EarlyReject ( const std::vector<Filter_t> & dFilters, const BlockTester_i & tBlockTester ) const
 {
+	std::vector<HeaderWithLocator_t> dPruneHeaders;
+	std::vector<uint8_t> dMatchingSubblocks = GetMatchingSubblocks ( dFilters, dPruneHeaders );
+	if ( !dMatchingSubblocks.empty() && std::none_of ( dMatchingSubblocks.begin(), dMatchingSubblocks.end(), []( uint8_t uMatch ){ return !!uMatch; } ) )
+		return true;
+
 	std::vector<HeaderWithLocator_t> dHeaders = GetHeadersForMinMax(dFilters);
 	if ( dHeaders.empty() )
 		return false;
@@ -742,9 +2286,121 @@ bool Columnar_c::IsFilterDegenerate ( const Filter_t & tFilter ) const
 }
 
 
-std::vector<BlockIterator_i *> Columnar_c::TryToCreateAnalyzers ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, SharedBlocks_c & pMatchingBlocks ) const
+void Columnar_c::GetSubblockCacheStats ( SubblockCacheStats_t & tStats ) const
 {
-	std::vector<BlockIterator_i*> dAnalyzers;
+	tStats = SubblockCacheStats_t();
+	if ( m_pSubblockCache )
+		m_pSubblockCache->GetStats(tStats);
+}
+
+
+std::pair<int64_t,int64_t> Columnar_c::GetAttributeBodyRange ( int iAttr ) const
+{
+	// attribute bodies are stored back to back in directory order, so a body ends where the next one starts
+	int64_t iEnd = iAttr+1<(int)m_dAttrs.size() ? m_dAttrs[iAttr+1]->m_iBodyOffset : m_iFileSize;
+	return { m_dAttrs[iAttr]->m_iBodyOffset, iEnd };
+}
+
+
+bool Columnar_c::PrefaultAttributes ( const std::vector<std::string> & dAttrs, const ResidencySettings_t & tSettings, std::string & sError ) const
+{
+	if ( !ShouldMmap() )
+	{
+		sError = "prefaulting attributes requires mmap mode";
+		return false;
+	}
+
+	// doesn't need the headers, so prefaulting doesn't load them in lazy mode
+	std::vector<int> dToPrefault;
+	for ( const auto & sAttr : dAttrs )
+	{
+		auto tFound = m_hAttrs.find(sAttr);
+		if ( tFound==m_hAttrs.end() )
+		{
+			sError = FormatStr ( "attribute '%s' not found", sAttr.c_str() );
+			return false;
+		}
+
+		dToPrefault.push_back ( tFound->second );
+
+		// string filters may be evaluated over the hashes
+		auto tHashFound = m_dAttrs[tFound->second]->m_eType==AttrType_e::STRING ? m_hAttrs.find ( GenerateHashAttrName(sAttr) ) : m_hAttrs.end();
+		if ( tHashFound!=m_hAttrs.end() )
+			dToPrefault.push_back ( tHashFound->second );
+	}
+
+	const uint8_t * pMap = (const uint8_t *)m_pMap->GetPtr();
+	for ( auto iAttr : dToPrefault )
+	{
+		auto tRange = GetAttributeBodyRange(iAttr);
+		if ( !PrefaultMapped ( pMap+tRange.first, tRange.second-tRange.first, tSettings.m_bLock, tSettings.m_bHugePages, sError ) )
+		{
+			sError = FormatStr ( "attribute '%s': %s", m_dAttrs[iAttr]->m_sName.c_str(), sError.c_str() );
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+void Columnar_c::GetAttributeStats ( std::vector<AttributeStats_t> & dStats ) const
+{
+	dStats.resize ( m_dAttrs.size() );
+	for ( size_t i = 0; i < m_dAttrs.size(); i++ )
+	{
+		AttributeStats_t & tStats = dStats[i];
+		tStats = AttributeStats_t();
+		tStats.m_sName = m_dAttrs[i]->m_sName;
+
+		auto tRange = GetAttributeBodyRange ( (int)i );
+		tStats.m_iDataBytes = tRange.second-tRange.first;
+		if ( ShouldMmap() )
+		{
+			tStats.m_iMappedBytes = tStats.m_iDataBytes;
+			tStats.m_iResidentBytes = GetResidentBytes ( (const uint8_t *)m_pMap->GetPtr()+tRange.first, tStats.m_iDataBytes );
+		}
+		else
+			tStats.m_iMappedBytes = tStats.m_iResidentBytes = 0;
+
+		// headers that were not loaded yet (lazy mode) use no memory and have no counters
+		const AttributeHeader_i * pHeader = m_dAttrs[i]->m_pLoaded.load ( std::memory_order_acquire );
+		if ( !pHeader )
+			continue;
+
+		tStats.m_iHeaderBytes = pHeader->GetHeaderMemory();
+		tStats.m_iMinMaxBytes = pHeader->GetMinMaxMemory();
+
+		const AttributeCounters_t & tCounters = pHeader->GetCounters();
+		tStats.m_iBlocksDecoded = tCounters.m_iBlocksDecoded.load ( std::memory_order_relaxed );
+		tStats.m_iSubblocksSkipped = tCounters.m_iSubblocksSkipped.load ( std::memory_order_relaxed );
+		tStats.m_iBytesRead = tCounters.m_iBytesRead.load ( std::memory_order_relaxed );
+	}
+}
+
+
+// a cheap guess at how selective a filter is, lower is more selective; only used to order fused analyzers, so no min-max walk
+// sorted ranges get 0: their rowids are known upfront and nothing gets decoded
+static int GetFilterRank ( const Filter_t & tFilter )
+{
+	if ( tFilter.m_bExclude )
+		return 4;
+
+	switch ( tFilter.m_eType )
+	{
+	case FilterType_e::VALUES:
+	case FilterType_e::STRINGS:		return 1;
+	case FilterType_e::RANGE:
+	case FilterType_e::FLOATRANGE:
+	case FilterType_e::PREFIX:		return 2;
+	default:						return 3;
+	}
+}
+
+
+std::vector<AnalyzerPlan_t> Columnar_c::PlanAnalyzers ( const std::vector<Filter_t> & dFilters ) const
+{
+	std::vector<AnalyzerPlan_t> dPlan;
 
 	for ( size_t i = 0; i<dFilters.size(); i++ )
 	{
@@ -754,22 +2410,133 @@ std::vector<BlockIterator_i *> Columnar_c::TryToCreateAnalyzers ( const std::vec
 			continue;
 
 		const AttributeHeader_i * pHeader = GetHeader ( tFilter.m_sName );
-		if ( pHeader )
+		if ( !pHeader )
+			continue;
+
+		AnalyzerPlan_t & tPlan = dPlan.emplace_back();
+		tPlan.m_iFilter = (int)i;
+		tPlan.m_pHeader = pHeader;
+		tPlan.m_bRowIdRange = ResolveSortedRange ( tFilter, *pHeader, tPlan.m_tMinRowID, tPlan.m_tMaxRowID );
+	}
+
+	for ( auto & i : dPlan )
+		i.m_iRank = i.m_bRowIdRange ? 0 : GetFilterRank ( dFilters[i.m_iFilter] );
+
+	return dPlan;
+}
+
+
+std::vector<BlockIterator_i *> Columnar_c::CreateAnalyzers ( std::vector<AnalyzerPlan_t> & dPlan, const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, SharedBlocks_c & pMatchingBlocks ) const
+{
+	std::vector<BlockIterator_i*> dAnalyzers;
+
+	for ( size_t i = 0; i<dPlan.size(); )
+	{
+		const auto & tPlan = dPlan[i];
+		const auto & tFilter = dFilters[tPlan.m_iFilter];
+
+		BlockIterator_i * pIterator = nullptr;
+		if ( tPlan.m_bRowIdRange )
+			pIterator = new RowIdRangeIterator_c ( tFilter.m_sName, tPlan.m_tMinRowID, tPlan.m_tMaxRowID, tPlan.m_pHeader->GetSettings().m_iSubblockSize, pMatchingBlocks );
+		else
 		{
 			Analyzer_i * pAnalyzer = CreateAnalyzer ( tFilter, !!pMatchingBlocks );
 			if ( pAnalyzer )
-			{
-				pAnalyzer->Setup ( pMatchingBlocks, pHeader->GetNumDocs() );
-				dAnalyzers.push_back(pAnalyzer);
-				dDeletedFilters.push_back ( (int)i );
-			}
+				pAnalyzer->Setup ( pMatchingBlocks, tPlan.m_pHeader->GetNumDocs() );
+
+			pIterator = pAnalyzer;
+		}
+
+		// whether an analyzer can be created depends only on the filter; drop it from the plan for the remaining partitions
+		if ( !pIterator )
+		{
+			dPlan.erase ( dPlan.begin()+i );
+			continue;
 		}
+
+		dAnalyzers.push_back(pIterator);
+		dDeletedFilters.push_back ( tPlan.m_iFilter );
+		i++;
 	}
 
 	return dAnalyzers;
 }
 
 
+// first rowid where fnPasses (false..true over a sorted attribute) is true; leaves are located by their last value, rows inside a leaf via the iterator
+template <typename PASSES>
+static uint32_t FindFirstPassing ( const AttributeHeader_i & tHeader, Iterator_i & tIterator, bool bAsc, PASSES && fnPasses )
+{
+	int iLeafLevel = tHeader.GetNumMinMaxLevels()-1;
+	int iNumLeaves = tHeader.GetNumMinMaxBlocks(iLeafLevel);
+	int iLeafShift = CalcNumBits ( tHeader.GetSettings().m_iSubblockSize )-1;
+	uint32_t uNumDocs = tHeader.GetNumDocs();
+
+	int iLeaf = 0;
+	int iLeafEnd = iNumLeaves;
+	while ( iLeaf<iLeafEnd )
+	{
+		int iMid = ( iLeaf+iLeafEnd ) >> 1;
+		auto tMinMax = tHeader.GetMinMax ( iLeafLevel, iMid );
+		if ( fnPasses ( bAsc ? tMinMax.second : tMinMax.first ) )
+			iLeafEnd = iMid;
+		else
+			iLeaf = iMid+1;
+	}
+
+	if ( iLeaf>=iNumLeaves )
+		return uNumDocs;
+
+	uint32_t tRowID = uint32_t(iLeaf) << iLeafShift;
+	uint32_t tRowIDEnd = std::min ( tRowID + ( 1U<<iLeafShift ), uNumDocs );
+	while ( tRowID<tRowIDEnd )
+	{
+		uint32_t tMid = tRowID + ( ( tRowIDEnd-tRowID ) >> 1 );
+		if ( fnPasses ( tIterator.Get(tMid) ) )
+			tRowIDEnd = tMid;
+		else
+			tRowID = tMid+1;
+	}
+
+	return tRowID;
+}
+
+
+bool Columnar_c::ResolveSortedRange ( const Filter_t & tFilter, const AttributeHeader_i & tHeader, uint32_t & tMinRowID, uint32_t & tMaxRowID ) const
+{
+	auto eType = tHeader.GetType();
+	if ( eType!=AttrType_e::UINT32 && eType!=AttrType_e::TIMESTAMP && eType!=AttrType_e::INT64 && eType!=AttrType_e::FLOAT )
+		return false;
+
+	SortOrder_e eOrder = tHeader.GetSortOrder();
+	if ( eOrder==SortOrder_e::NONE || !tHeader.GetNumMinMaxLevels() )
+		return false;
+
+	Filter_t tFixedFilter = tFilter;
+	FixupFilterSettings ( tFixedFilter, eType );
+	FilterEval_c tEval(tFixedFilter);
+	if ( !tEval.IsInterval() )
+		return false;
+
+	std::string sError;
+	std::unique_ptr<Iterator_i> pIterator ( CreateIterator ( tFilter.m_sName, IteratorHints_t(), nullptr, sError ) );
+	if ( !pIterator )
+		return false;
+
+	// ascending: rows pass the lower bound from some point on and stop passing the upper one later; descending is the mirror image
+	bool bAsc = eOrder==SortOrder_e::ASC;
+	auto fnMin = [&tEval]( int64_t iValue ){ return tEval.PassesMin(iValue); };
+	auto fnMax = [&tEval]( int64_t iValue ){ return tEval.PassesMax(iValue); };
+	auto fnNotMin = [&tEval]( int64_t iValue ){ return !tEval.PassesMin(iValue); };
+	auto fnNotMax = [&tEval]( int64_t iValue ){ return !tEval.PassesMax(iValue); };
+
+	tMinRowID = bAsc ? FindFirstPassing ( tHeader, *pIterator, bAsc, fnMin ) : FindFirstPassing ( tHeader, *pIterator, bAsc, fnMax );
+	tMaxRowID = bAsc ? FindFirstPassing ( tHeader, *pIterator, bAsc, fnNotMax ) : FindFirstPassing ( tHeader, *pIterator, bAsc, fnNotMin );
+	tMaxRowID = std::max ( tMinRowID, tMaxRowID );
+	return true;
+}
+
+
 std::vector<BlockIterator_i *> Columnar_c::TryToCreatePrefilter ( const std::vector<HeaderWithLocator_t> & dHeaders, SharedBlocks_c pMatchingBlocks ) const
 {
 	if ( !pMatchingBlocks )
@@ -785,40 +2552,204 @@ std::vector<BlockIterator_i *> Columnar_c::TryToCreatePrefilter ( const std::vec
 
 const AttributeHeader_i * Columnar_c::GetHeader ( const std::string & sName ) const
 {
-	const auto & tFound = m_hHeaders.find(sName);
-	return tFound==m_hHeaders.end() ? nullptr : tFound->second.first;
+	std::string sError;
+	return GetHeader ( sName, sError );
 }
 
 
-bool Columnar_c::LoadHeaders ( FileReader_c & tReader, int iNumAttrs, std::string & sError )
+const AttributeHeader_i * Columnar_c::GetHeader ( const std::string & sName, std::string & sError ) const
+{
+	const auto & tFound = m_hAttrs.find(sName);
+	if ( tFound==m_hAttrs.end() )
+	{
+		sError = FormatStr ( "Attribute '%s' not found", sName.c_str() );
+		return nullptr;
+	}
+
+	return GetHeader ( tFound->second, sError );
+}
+
+
+const AttributeHeader_i * Columnar_c::GetHeader ( int iAttr ) const
 {
-	m_dHeaders.resize(iNumAttrs);
+	std::string sError;
+	return GetHeader ( iAttr, sError );
+}
+
+
+const AttributeHeader_i * Columnar_c::GetHeader ( int iAttr, std::string & sError ) const
+{
+	AttributeSlot_t & tAttr = *m_dAttrs[iAttr];
+	const AttributeHeader_i * pHeader = tAttr.m_pLoaded.load ( std::memory_order_acquire );
+	if ( pHeader )
+		return pHeader;
 
-	for ( size_t i = 0; i < m_dHeaders.size(); i++ )
+	std::lock_guard<std::mutex> tLock ( m_tHeaderLock );
+	if ( tAttr.m_pHeader )
+		return tAttr.m_pHeader.get();
+
+	if ( !tAttr.m_sLoadError.empty() )
 	{
-		AttrType_e eType = AttrType_e ( tReader.Read_uint32() );
-		std::unique_ptr<AttributeHeader_i> pHeader ( CreateAttributeHeader ( eType, m_uTotalDocs, sError ) );
-		if ( !pHeader )
+		sError = tAttr.m_sLoadError;
+		return nullptr;
+	}
+
+	// m_tReader is not thread-safe; use a separate reader on the same fd
+	FileReader_c tReader ( m_tReader.GetFD() );
+	std::string sLoadError;
+	if ( !LoadHeader ( tAttr, tReader, sLoadError ) )
+	{
+		tAttr.m_sLoadError = FormatStr ( "Unable to load header of attribute '%s': %s", tAttr.m_sName.c_str(), sLoadError.c_str() );
+		sError = tAttr.m_sLoadError;
+		return nullptr;
+	}
+
+	return tAttr.m_pHeader.get();
+}
+
+
+bool Columnar_c::LoadHeader ( AttributeSlot_t & tAttr, FileReader_c & tReader, std::string & sError ) const
+{
+	tReader.Seek ( tAttr.m_iHeaderOffset );
+	AttrType_e eType = AttrType_e ( tReader.Read_uint32() );
+	std::unique_ptr<AttributeHeader_i> pHeader ( CreateAttributeHeader ( eType, m_uTotalDocs, m_uVersion, sError ) );
+	if ( !pHeader )
+		return false;
+
+	if ( !pHeader->Load ( tReader, sError ) )
+		return false;
+
+	if ( tReader.IsError() )
+	{
+		sError = tReader.GetError();
+		return false;
+	}
+
+	tAttr.m_pHeader = std::move(pHeader);
+	tAttr.m_pLoaded.store ( tAttr.m_pHeader.get(), std::memory_order_release );
+	return true;
+}
+
+
+bool Columnar_c::LoadDirectory ( FileReader_c & tReader, int iNumAttrs, bool bLazyHeaders, std::string & sError )
+{
+	int64_t iDirOffset = (int64_t)tReader.Read_uint64();
+	if ( iDirOffset<=tReader.GetPos() || iDirOffset>=m_iFileSize )
+	{
+		sError = FormatStr ( "Attribute directory offset out of bounds: %lld", (long long)iDirOffset );
+		return false;
+	}
+
+	tReader.Seek(iDirOffset);
+	if ( m_uVersion>=23 )
+		m_iSubblockSize = (int)tReader.Read_uint32();
+
+	m_dAttrs.resize(iNumAttrs);
+	for ( size_t i = 0; i < m_dAttrs.size(); i++ )
+	{
+		auto pAttr = std::make_unique<AttributeSlot_t>();
+		pAttr->m_sName = tReader.Read_string();
+		pAttr->m_eType = AttrType_e ( tReader.Read_uint32() );
+		pAttr->m_iHeaderOffset = (int64_t)tReader.Read_uint64();
+		pAttr->m_iBodyOffset = (int64_t)tReader.Read_uint64();
+
+		m_hAttrs.insert ( { pAttr->m_sName, (int)i } );
+		m_dAttrs[i] = std::move(pAttr);
+	}
+
+	if ( tReader.IsError() )
+	{
+		sError = tReader.GetError();
+		return false;
+	}
+
+	if ( !CheckDirectory ( tReader.GetPos(), sError ) )
+		return false;
+
+	// older directories don't store the subblock size; take it from the first header
+	if ( !bLazyHeaders || m_uVersion<23 )
+		if ( !LoadHeader ( *m_dAttrs[0], tReader, sError ) )
+			return false;
+
+	if ( m_uVersion<23 )
+		m_iSubblockSize = m_dAttrs[0]->m_pHeader->GetSettings().m_iSubblockSize;
+
+	if ( bLazyHeaders )
+		return true;
+
+	for ( size_t i = 1; i < m_dAttrs.size(); i++ )
+		if ( !LoadHeader ( *m_dAttrs[i], tReader, sError ) )
+			return false;
+
+	return true;
+}
+
+
+bool Columnar_c::CheckDirectory ( int64_t iDirEnd, std::string & sError ) const
+{
+	// headers precede the directory, bodies follow it back to back
+	int64_t iPrevBody = iDirEnd;
+	for ( const auto & i : m_dAttrs )
+	{
+		if ( i->m_iHeaderOffset<=0 || i->m_iHeaderOffset>=iDirEnd )
+		{
+			sError = FormatStr ( "Header offset of attribute '%s' out of bounds: %lld", i->m_sName.c_str(), (long long)i->m_iHeaderOffset );
+			return false;
+		}
+
+		if ( i->m_iBodyOffset<iPrevBody || i->m_iBodyOffset>m_iFileSize )
+		{
+			sError = FormatStr ( "Body offset of attribute '%s' out of bounds: %lld", i->m_sName.c_str(), (long long)i->m_iBodyOffset );
 			return false;
+		}
+
+		iPrevBody = i->m_iBodyOffset;
+	}
+
+	return true;
+}
+
+
+bool Columnar_c::LoadHeaders ( FileReader_c & tReader, int iNumAttrs, std::string & sError )
+{
+	m_dAttrs.resize(iNumAttrs);
 
-		if ( !pHeader->Load ( tReader, sError ) )
+	for ( size_t i = 0; i < m_dAttrs.size(); i++ )
+	{
+		auto pAttr = std::make_unique<AttributeSlot_t>();
+		pAttr->m_iHeaderOffset = tReader.GetPos();
+		if ( !LoadHeader ( *pAttr, tReader, sError ) )
 			return false;
 
-		m_dHeaders[i] = std::move(pHeader);
-		m_hHeaders.insert ( { m_dHeaders[i]->GetName(), { m_dHeaders[i].get(), (int)i } } );
+		pAttr->m_sName = pAttr->m_pHeader->GetName();
+		pAttr->m_eType = pAttr->m_pHeader->GetType();
+
+		m_hAttrs.insert ( { pAttr->m_sName, (int)i } );
+		m_dAttrs[i] = std::move(pAttr);
 		tReader.Seek ( tReader.Read_uint64() );
 	}
 
+	m_iSubblockSize = m_dAttrs[0]->m_pHeader->GetSettings().m_iSubblockSize;
+
+	// no directory, so body offsets come from the headers; attributes without blocks have empty bodies
+	int64_t iBodyEnd = m_iFileSize;
+	for ( auto i = m_dAttrs.rbegin(); i!=m_dAttrs.rend(); ++i )
+	{
+		const AttributeHeader_i & tHeader = *(*i)->m_pHeader;
+		(*i)->m_iBodyOffset = tHeader.GetNumBlocks() ? (int64_t)tHeader.GetBlockOffset(0) : iBodyEnd;
+		iBodyEnd = (*i)->m_iBodyOffset;
+	}
+
 	return true;
 }
 
 } // namespace columnar
 
 
-columnar::Columnar_i * CreateColumnarStorageReader ( const std::string & sFilename, uint32_t uTotalDocs, bool bMmap, std::string & sError )
+columnar::Columnar_i * CreateColumnarStorageReader ( const std::string & sFilename, uint32_t uTotalDocs, bool bMmap, uint64_t uSubblockCacheSize, bool bLazyHeaders, std::string & sError )
 {
-	std::unique_ptr<columnar::Columnar_c> pColumnar ( new columnar::Columnar_c ( sFilename, uTotalDocs ) );
-	if ( !pColumnar->Setup ( bMmap, sError ) )
+	std::unique_ptr<columnar::Columnar_c> pColumnar ( new columnar::Columnar_c ( sFilename, uTotalDocs, uSubblockCacheSize ) );
+	if ( !pColumnar->Setup ( bMmap, bLazyHeaders, sError ) )
 		return nullptr;
 
 	return pColumnar.release();
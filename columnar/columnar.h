@@ -28,7 +28,17 @@
 namespace columnar
 {
 
-static const int LIB_VERSION = 28;
+static const int LIB_VERSION = 43;
+
+// caller-provided memory for packed values, e.g. a bump allocator that is reset after each batch of rows
+class PackedArena_i
+{
+public:
+	virtual				~PackedArena_i() = default;
+
+	virtual uint8_t *	Allocate ( size_t tSize ) = 0;	// memory must stay valid until the caller resets the arena
+};
+
 
 class Iterator_i
 {
@@ -38,14 +48,100 @@ public:
 	virtual	int64_t		Get ( uint32_t tRowID ) = 0;
 	virtual	void		Fetch ( const util::Span_T<uint32_t> & dRowIDs, util::Span_T<int64_t> & dValues ) = 0;
 
+	// typed batch fetch; values are stored in the column's native width (uint32/timestamp, float, bool)
+	// other columns are converted: 64-bit values are clamped to uint32, ints become floats, uint8 gets value!=0; strings and MVAs give zeroes
+	virtual	void		Fetch ( const util::Span_T<uint32_t> & dRowIDs, util::Span_T<uint32_t> & dValues ) = 0;
+	virtual	void		Fetch ( const util::Span_T<uint32_t> & dRowIDs, util::Span_T<float> & dValues ) = 0;
+	virtual	void		Fetch ( const util::Span_T<uint32_t> & dRowIDs, util::Span_T<uint8_t> & dValues ) = 0;
+
 	virtual	int			Get ( uint32_t tRowID, const uint8_t * & pData ) = 0;
 	virtual	uint8_t *	GetPacked ( uint32_t tRowID ) = 0;
+	virtual	uint8_t *	GetPacked ( uint32_t tRowID, PackedArena_i & tArena ) = 0;	// same as above, but allocates from tArena instead of new[]
 	virtual	int			GetLength ( uint32_t tRowID ) = 0;
 
+	// batch fetch; rowids must be sorted. value i is stored in dBlob at [dOffsets[i], dOffsets[i+1]); MVA values are raw uint32/int64 arrays
+	virtual	void		FetchStrings ( const util::Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets ) = 0;
+	virtual	void		FetchMva ( const util::Span_T<uint32_t> & dRowIDs, std::vector<uint8_t> & dBlob, std::vector<int64_t> & dOffsets ) = 0;
+
 	virtual void		AddDesc ( std::vector<common::IteratorDesc_t> & dDesc ) const = 0;
 };
 
 
+enum class ScanPacking_e
+{
+	CONST,		// all values in the span are equal to m_iValue
+	TABLE,		// m_dIndexes point into the per-block m_dTable
+	VALUES		// decoded values are in m_dValues32 or m_dValues64, depending on attribute width
+};
+
+// a run of values returned by the scan cursor; spans point to cursor-owned (or shared cache) memory, are read-only and valid until the next call
+// values have the same representation as the ones returned by Iterator_i::Get (e.g. floats are stored as their bits)
+struct ScanSpan_t
+{
+	uint32_t				m_tRowID = 0;		// rowid of the 1st value in the span
+	int						m_iNumValues = 0;
+	ScanPacking_e			m_ePacking = ScanPacking_e::CONST;
+	int64_t					m_iValue = 0;
+	util::Span_T<int64_t>	m_dTable;
+	util::Span_T<uint32_t>	m_dIndexes;
+	util::Span_T<const uint32_t>	m_dValues32;
+	util::Span_T<const uint64_t>	m_dValues64;
+};
+
+class ScanCursor_i
+{
+public:
+	virtual			~ScanCursor_i() = default;
+
+	virtual bool	GetNextSpan ( ScanSpan_t & tSpan ) = 0;
+	virtual void	Reset ( uint32_t tMinRowID, uint32_t tMaxRowID ) = 0;	// restarts the scan on [tMinRowID, tMaxRowID); already decoded data is reused
+};
+
+
+enum class AggrFunc_e
+{
+	COUNT,
+	SUM,
+	MIN,
+	MAX
+};
+
+struct AggrSpec_t
+{
+	AggrFunc_e		m_eFunc = AggrFunc_e::COUNT;
+	std::string		m_sAttr;	// not used by COUNT
+};
+
+struct AggrResult_t
+{
+	int64_t			m_iCount = 0;		// number of rows that passed the filters
+	int64_t			m_iValue = 0;		// COUNT and SUM/MIN/MAX over integer attributes
+	double			m_fValue = 0.0;		// SUM/MIN/MAX over float attributes
+};
+
+struct TopKMatch_t
+{
+	uint32_t		m_tRowID = 0;
+	int64_t			m_iValue = 0;		// same representation as Iterator_i::Get (floats are stored as their bits)
+};
+
+struct GroupCount_t
+{
+	int64_t			m_iValue = 0;		// integer attributes and MVA elements
+	std::string		m_sValue;			// string attributes
+	int64_t			m_iCount = 0;
+};
+
+// counts rows per distinct value (per distinct element for MVA); TABLE blocks are counted by dictionary code
+class GroupCounter_i
+{
+public:
+	virtual			~GroupCounter_i() = default;
+
+	virtual void	Count ( uint32_t tMinRowID, uint32_t tMaxRowID ) = 0;	// adds rows in [tMinRowID, tMaxRowID) to the counts
+	virtual void	GetGroups ( std::vector<GroupCount_t> & dGroups ) const = 0;
+};
+
 using MinMaxVec_t = std::vector<std::pair<int64_t,int64_t>>;
 
 class BlockTester_i
@@ -79,6 +175,43 @@ struct AttrInfo_t
 	bool				m_bStablePtr = false;
 };
 
+struct SubblockCacheStats_t
+{
+	int64_t		m_iHits = 0;
+	int64_t		m_iMisses = 0;
+	int64_t		m_iEvictions = 0;
+	int64_t		m_iEntries = 0;
+	int64_t		m_iSize = 0;		// bytes used by decoded subblocks
+	int64_t		m_iMaxSize = 0;
+};
+
+struct ResidencySettings_t
+{
+	bool		m_bLock = false;		// mlock the pages, so they are not evicted under memory pressure
+	bool		m_bHugePages = false;	// ask for transparent huge pages; best effort, depends on kernel support
+};
+
+struct AttributeStats_t
+{
+	std::string	m_sName;
+	int64_t		m_iHeaderBytes = 0;			// RAM used by the header: block offsets, packings, bloom filters
+	int64_t		m_iMinMaxBytes = 0;			// RAM used by the min-max tree(s)
+	int64_t		m_iDataBytes = 0;			// on-disk size of the attribute data
+	int64_t		m_iMappedBytes = 0;			// 0 unless the storage is mmapped
+	int64_t		m_iResidentBytes = 0;		// mapped bytes currently in RAM; -1 if unknown
+	int64_t		m_iBlocksDecoded = 0;
+	int64_t		m_iSubblocksSkipped = 0;	// subblocks discarded by min-max and bloom filters before reading
+	int64_t		m_iBytesRead = 0;			// bytes read from the file (or the mapping) by all iterators and analyzers
+};
+
+// a rowid range of the segment with its own set of analyzers; partitions share no mutable state and can be processed concurrently
+struct AnalyzerPartition_t
+{
+	uint32_t	m_tMinRowID = 0;	// the partition covers [m_tMinRowID, m_tMaxRowID)
+	uint32_t	m_tMaxRowID = 0;
+	std::vector<common::BlockIterator_i *> m_dIterators;
+};
+
 
 class Columnar_i
 {
@@ -87,11 +220,19 @@ public:
 
 	virtual Iterator_i *	CreateIterator ( const std::string & sName, const IteratorHints_t & tHints, columnar::IteratorCapabilities_t * pCapabilities, std::string & sError ) const = 0;
 	virtual std::vector<common::BlockIterator_i *> CreateAnalyzerOrPrefilter ( const std::vector<common::Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester ) const = 0;
+	virtual std::vector<AnalyzerPartition_t> CreatePartitionedAnalyzerOrPrefilter ( const std::vector<common::Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester, int iNumPartitions ) const = 0;	// partitions are aligned to 64k-row blocks; partitions with no matches are omitted. Nothing matches: one empty partition with an iterator that yields no rows; no partitions: no analyzers, do a plain scan
 	virtual int64_t			EstimateMinMax ( const common::Filter_t & tFilter, const BlockTester_i & tBlockTester ) const = 0;
 	virtual bool			GetAttrInfo ( const std::string & sName, AttrInfo_t & tInfo ) const = 0;
+	virtual bool			Aggregate ( const std::vector<common::Filter_t> & dFilters, const std::vector<AggrSpec_t> & dAggrs, std::vector<AggrResult_t> & dResults, std::string & sError ) const = 0;	// deleted rows are not accounted for
+	virtual bool			TopK ( const std::string & sAttr, bool bDesc, int iK, common::BlockIterator_i * pRowIdFilter, std::vector<TopKMatch_t> & dResult, std::string & sError ) const = 0;	// k best rows, best first; ties go to lower rowids. pRowIdFilter is optional and gets fully consumed
+	virtual GroupCounter_i *	CreateGroupCounter ( const std::string & sName, std::string & sError ) const = 0;
+	virtual ScanCursor_i *	CreateScanCursor ( const std::string & sName, uint32_t tMinRowID, uint32_t tMaxRowID, std::string & sError ) const = 0;	// scans [tMinRowID, tMaxRowID)
 
 	virtual bool			EarlyReject ( const std::vector<common::Filter_t> & dFilters, const BlockTester_i & tBlockTester ) const = 0;
 	virtual bool			IsFilterDegenerate ( const common::Filter_t & tFilter ) const = 0;
+	virtual void			GetSubblockCacheStats ( SubblockCacheStats_t & tStats ) const = 0;	// all zeroes if the cache is disabled
+	virtual bool			PrefaultAttributes ( const std::vector<std::string> & dAttrs, const ResidencySettings_t & tSettings, std::string & sError ) const = 0;	// mmap mode only; blocks until the data is read in
+	virtual void			GetAttributeStats ( std::vector<AttributeStats_t> & dStats ) const = 0;	// one entry per stored attribute (including hash attributes); counters are cumulative since load
 };
 
 } // namespace columnar
@@ -99,7 +240,7 @@ public:
 
 extern "C"
 {
-	DLLEXPORT columnar::Columnar_i *	CreateColumnarStorageReader ( const std::string & sFilename, uint32_t uTotalDocs, bool bMmap, std::string & sError );
+	DLLEXPORT columnar::Columnar_i *	CreateColumnarStorageReader ( const std::string & sFilename, uint32_t uTotalDocs, bool bMmap, uint64_t uSubblockCacheSize, bool bLazyHeaders, std::string & sError );	// uSubblockCacheSize=0 disables the decoded subblock cache; bLazyHeaders loads attribute headers on first use
 	DLLEXPORT void						CheckColumnarStorage ( const std::string & sFilename, uint32_t uNumRows, columnar::Reporter_fn & fnError, columnar::Reporter_fn & fnProgress );
 	DLLEXPORT int						GetColumnarLibVersion();
 	DLLEXPORT const char *				GetColumnarLibVersionStr();
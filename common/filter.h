@@ -32,7 +32,9 @@ enum class FilterType_e
 	RANGE,
 	FLOATRANGE,
 	STRINGS,
-	NOTNULL
+	NOTNULL,
+	PREFIX,		// any of m_dStringValues is a prefix of the value; compared bytewise
+	CONTAINS	// any of m_dStringValues is a substring of the value; compared bytewise
 };
 
 
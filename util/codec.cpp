@@ -551,4 +551,17 @@ std::shared_ptr<IntCodec_c> CreateIntCodecShared ( const std::string & sCodec32,
 	return std::shared_ptr<IntCodec_c> ( pCodec.release(), tDeleter );
 }
 
+const std::string & GetAltIntCodecName ( const std::string & sCodec )
+{
+	static const std::string sSVB = "libstreamvbyte";
+	static const std::string sPFOR = "simdfastpfor128";
+	return sCodec==sSVB ? sPFOR : sSVB;
+}
+
+float GetIntCodecDecodeCost ( const std::string & sCodec )
+{
+	// streamvbyte decodes noticeably faster, so other codecs have to win by a margin
+	return sCodec=="libstreamvbyte" ? 1.0f : 1.2f;
+}
+
 } // namespace util
@@ -73,4 +73,9 @@ using IntCodecPooledPtr_t = std::unique_ptr<IntCodec_c, CodecPoolDeleter_t>;
 IntCodecPooledPtr_t CreateIntCodec ( const std::string & sCodec32, const std::string & sCodec64 );
 std::shared_ptr<IntCodec_c> CreateIntCodecShared ( const std::string & sCodec32, const std::string & sCodec64 );
 
+// adaptive subblock encoding tries the configured codec and its alternative
+const std::string & GetAltIntCodecName ( const std::string & sCodec );
+// relative decode cost per encoded byte, used to weigh the encoded sizes
+float GetIntCodecDecodeCost ( const std::string & sCodec );
+
 } // namespace util
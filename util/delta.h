@@ -29,6 +29,8 @@ FORCE_INLINE void	ComputeInverseDeltas ( std::vector<uint32_t> & dData, bool bAs
 FORCE_INLINE void	ComputeInverseDeltas ( std::vector<uint64_t> & dData, bool bAsc );
 FORCE_INLINE void	ComputeInverseDeltasAsc ( Span_T<uint32_t> & dData );
 FORCE_INLINE void	ComputeInverseDeltasAsc ( Span_T<uint64_t> & dData );
+FORCE_INLINE void	ComputeXorDeltas ( uint32_t * pData, int iLength );
+FORCE_INLINE void	ComputeInverseXorDeltas ( Span_T<uint32_t> & dData );
 
 } // namespace util
 
@@ -277,4 +277,106 @@ FORCE_INLINE void ComputeInverseDeltasAsc ( Span_T<uint64_t> & dData )
 	CalcInverseDelta64 ( dData.data(), dData.size() );
 }
 
+
+template <typename T>
+FORCE_INLINE T ZigzagEncode ( T tValue )
+{
+	using S = std::make_signed_t<T>;
+	return ( tValue << 1 ) ^ T ( S(tValue) >> ( sizeof(T)*8-1 ) );
+}
+
+
+template <typename T>
+FORCE_INLINE T ZigzagDecode ( T tValue )
+{
+	return ( tValue >> 1 ) ^ ( T(0) - ( tValue & 1 ) );
+}
+
+// [v0, v1, v2, ...] -> [0, zz(v1-v0), zz((v2-v1)-(v1-v0)), ...]; regularly spaced values turn into (mostly) zeroes
+template <typename T>
+FORCE_INLINE void ComputeDeltasOfDeltas ( T * pData, size_t tLength )
+{
+	if ( !tLength )
+		return;
+
+	Delta ( pData, tLength );
+	pData[0] = 0;
+	Delta ( pData, tLength );
+
+	for ( size_t i = 1; i < tLength; i++ )
+		pData[i] = ZigzagEncode ( pData[i] );
+}
+
+// undoes ComputeDeltasOfDeltas: zigzag decode, then two prefix sums (the 2nd one starts from the first value)
+FORCE_INLINE void ComputeInverseDeltasOfDeltas ( Span_T<uint32_t> & dData, uint32_t uFirst )
+{
+	uint32_t * pData = dData.data();
+	size_t iTotalQty = dData.size();
+	if ( !iTotalQty )
+		return;
+
+	const size_t iQty4 = iTotalQty >> 2;
+	const __m128i tOne = _mm_set1_epi32(1);
+	__m128i * pCurr = reinterpret_cast<__m128i *>(pData);
+	const __m128i * pEnd = pCurr + iQty4;
+	while ( pCurr < pEnd )
+	{
+		__m128i a0 = _mm_loadu_si128(pCurr);
+		__m128i tSign = _mm_sub_epi32 ( _mm_setzero_si128(), _mm_and_si128 ( a0, tOne ) );
+		_mm_storeu_si128 ( pCurr++, _mm_xor_si128 ( _mm_srli_epi32 ( a0, 1 ), tSign ) );
+	}
+
+	for ( size_t i = iQty4 << 2; i < iTotalQty; ++i )
+		pData[i] = ZigzagDecode ( pData[i] );
+
+	FastInverseDeltaUnaligned ( pData, iTotalQty );
+	pData[0] = uFirst;
+	FastInverseDeltaUnaligned ( pData, iTotalQty );
+}
+
+
+FORCE_INLINE void ComputeInverseDeltasOfDeltas ( Span_T<uint64_t> & dData, uint64_t uFirst )
+{
+	if ( dData.empty() )
+		return;
+
+	for ( auto & i : dData )
+		i = ZigzagDecode(i);
+
+	InverseDelta ( dData.data(), dData.size() );
+	dData[0] = uFirst;
+	InverseDelta ( dData.data(), dData.size() );
+}
+
+
+FORCE_INLINE void ComputeXorDeltas ( uint32_t * pData, int iLength )
+{
+	for ( int i = iLength - 1; i > 0; --i )
+		pData[i] ^= pData[i-1];
+}
+
+// same as FastInverseDeltaUnaligned, but with a running xor instead of a running sum
+FORCE_INLINE void ComputeInverseXorDeltas ( Span_T<uint32_t> & dData )
+{
+	uint32_t * pData = dData.data();
+	size_t iTotalQty = dData.size();
+
+	const size_t iQty4 = iTotalQty >> 2;
+	__m128i tRunningXor = _mm_setzero_si128();
+	__m128i * pCurr = reinterpret_cast<__m128i *>(pData);
+	const __m128i * pEnd = pCurr + iQty4;
+	while ( pCurr < pEnd )
+	{
+		__m128i a0 = _mm_loadu_si128(pCurr);
+		__m128i a1 = _mm_xor_si128 ( _mm_slli_si128 ( a0, 8 ), a0 );
+		__m128i a2 = _mm_xor_si128 ( _mm_slli_si128 ( a1, 4 ), a1 );
+		a0 = _mm_xor_si128 ( a2, tRunningXor );
+		tRunningXor = _mm_shuffle_epi32 ( a0, 0xFF );
+		_mm_storeu_si128 ( pCurr++, a0 );
+	}
+
+	for ( size_t i = std::max ( iQty4 << 2, (size_t)1 ); i < iTotalQty; ++i )
+		pData[i] ^= pData[i-1];
+}
+
 } // namespace util
@@ -30,6 +30,7 @@
 #else
 	#include <sys/mman.h>
 	#include <unistd.h>
+	#include <fcntl.h>
 	#define struct_stat        struct stat
 #endif
 
@@ -184,6 +185,7 @@ bool FileReader_c::DoRefill()
 	m_tUsed = iRead;
 	m_tPtr = 0;
 	m_iFilePos = iNewFilePos;
+	m_iBytesRead += iRead;
 
 	return true;
 }
@@ -231,6 +233,114 @@ static FORCE_INLINE int64_t RoundUpToPage ( int64_t iSize )
 #endif
 
 
+void FileReader_c::Prefetch ( int64_t iOffset, int64_t iLength ) const
+{
+	// starts kernel readahead into the page cache, so later preads don't block on the disk
+	// no-op where the hint is not available
+#if defined(POSIX_FADV_WILLNEED)
+	if ( m_iFD>=0 && iLength>0 )
+		::posix_fadvise ( m_iFD, (off_t)iOffset, (off_t)iLength, POSIX_FADV_WILLNEED );
+#endif
+}
+
+
+void PrefetchMapped ( const uint8_t * pMap, int64_t iMapSize, int64_t iOffset, int64_t iLength )
+{
+#if !_WIN32
+	iLength = std::min ( iLength, iMapSize-iOffset );
+	if ( !pMap || iLength<=0 )
+		return;
+
+	// madvise needs a page-aligned start
+	uintptr_t uStart = (uintptr_t)( pMap+iOffset );
+	uintptr_t uAligned = uStart & ~uintptr_t ( GetPageSize()-1 );
+	::madvise ( (void*)uAligned, size_t ( uStart-uAligned+iLength ), MADV_WILLNEED );
+#endif
+}
+
+
+bool PrefaultMapped ( const uint8_t * pMap, int64_t iLength, bool bLock, bool bHugePages, std::string & sError )
+{
+	if ( !pMap || iLength<=0 )
+		return true;
+
+#if _WIN32
+	size_t tPageSize = 4096;
+#else
+	size_t tPageSize = GetPageSize();
+#endif
+	uintptr_t uStart = (uintptr_t)pMap & ~uintptr_t ( tPageSize-1 );
+	size_t tLength = size_t ( (uintptr_t)pMap-uStart+iLength );
+	void * pStart = (void*)uStart;
+
+#if !_WIN32
+	// best effort; file-backed THP needs kernel support, so failures are not reported
+#if defined(MADV_HUGEPAGE)
+	if ( bHugePages )
+		::madvise ( pStart, tLength, MADV_HUGEPAGE );
+#endif
+
+	if ( bLock )
+	{
+		// mlock faults the pages in as well
+		if ( ::mlock ( pStart, tLength ) )
+		{
+			sError = FormatStr ( "mlock failed: %s (length=%lld)", strerror(errno), (long long)tLength );
+			return false;
+		}
+
+		return true;
+	}
+
+#if defined(MADV_POPULATE_READ)
+	if ( !::madvise ( pStart, tLength, MADV_POPULATE_READ ) )
+		return true;
+#endif
+
+	::madvise ( pStart, tLength, MADV_WILLNEED );
+#else
+	if ( bLock && !::VirtualLock ( pStart, tLength ) )
+	{
+		sError = FormatStr ( "VirtualLock failed (errno %u, length=%I64u)", ::GetLastError(), (uint64_t)tLength );
+		return false;
+	}
+#endif
+
+	// touch every page; this doesn't return until the data is read in
+	volatile uint8_t uSink = 0;
+	for ( size_t i = 0; i < tLength; i += tPageSize )
+		uSink += *( (const volatile uint8_t *)pStart + i );
+
+	return true;
+}
+
+
+int64_t GetResidentBytes ( const uint8_t * pMap, int64_t iLength )
+{
+	if ( !pMap || iLength<=0 )
+		return 0;
+
+#if _WIN32
+	return -1;
+#else
+	size_t tPageSize = GetPageSize();
+	uintptr_t uStart = (uintptr_t)pMap & ~uintptr_t ( tPageSize-1 );
+	size_t tLength = size_t ( (uintptr_t)pMap-uStart+iLength );
+	size_t tPages = ( tLength+tPageSize-1 ) / tPageSize;
+
+	std::vector<unsigned char> dResident(tPages);
+	if ( ::mincore ( (void*)uStart, tLength, dResident.data() ) )
+		return -1;
+
+	int64_t iResident = 0;
+	for ( auto i : dResident )
+		iResident += i & 1;
+
+	return std::min ( iResident*(int64_t)tPageSize, iLength );
+#endif
+}
+
+
 static void MMapClose ( MappedBufferData_t & tBuf );
 
 static bool MMapOpen ( const std::string & sFile, bool bWrite, std::string & sError, MappedBufferData_t & tBuf )
@@ -29,6 +29,7 @@ public:
 	int64_t					GetPos() const			{ return m_iFilePos+m_tPtr; }
 	size_t					GetBufferSize() const	{ return m_tSize; }
 	const std::string &		GetFilename() const		{ return m_sFile; }
+	int64_t					FlushBytesRead()		{ int64_t iRes = m_iBytesRead; m_iBytesRead = 0; return iRes; }	// bytes read from the file (or the mapping) since the last call
 
 	template <typename T> void Read ( T & tValue )	{ static_cast<D*>(this)->Read ( (uint8_t *)&tValue, sizeof(tValue) ); }
 
@@ -96,6 +97,7 @@ protected:
 	size_t      m_tUsed = 0;
 	size_t      m_tPtr = 0;
 	int64_t     m_iFilePos = 0;
+	int64_t     m_iBytesRead = 0;
 
 	bool        m_bError = false;
 	std::string m_sError;
@@ -129,6 +131,7 @@ public:
 	int64_t					GetFileSize();
 
 	std::shared_ptr<FileReader_c> Clone() const { return std::make_shared<FileReader_c> ( m_iFD, GetBufferSize() ); }
+	void					Prefetch ( int64_t iOffset, int64_t iLength ) const;	// async readahead hint; doesn't move the read position
 
 	using ReaderBase_T<FileReader_c>::Read;
 	void					Read ( uint8_t * pData, size_t tLen );
@@ -161,6 +164,10 @@ private:
 };
 
 
+void PrefetchMapped ( const uint8_t * pMap, int64_t iMapSize, int64_t iOffset, int64_t iLength );
+bool PrefaultMapped ( const uint8_t * pMap, int64_t iLength, bool bLock, bool bHugePages, std::string & sError );	// synchronously maps in [pMap, pMap+iLength)
+int64_t GetResidentBytes ( const uint8_t * pMap, int64_t iLength );	// bytes of [pMap, pMap+iLength) currently in RAM (page granularity); -1 if unknown
+
 class MappedReader_c : public ReaderBase_T<MappedReader_c>
 {
 public:
@@ -173,6 +180,7 @@ public:
 	}
 
 	std::shared_ptr<MappedReader_c> Clone() const { return std::make_shared<MappedReader_c> ( m_pBuf, (int64_t)m_tUsed ); }
+	void			Prefetch ( int64_t iOffset, int64_t iLength ) const { PrefetchMapped ( m_pBuf, (int64_t)m_tUsed, iOffset, iLength ); }
 
 	FORCE_INLINE void Seek ( int64_t iPos )
 	{
@@ -188,6 +196,7 @@ public:
 
 		const uint8_t * pRes = m_pBuf + m_tPtr;
 		m_tPtr += tLen;
+		m_iBytesRead += tLen;
 		return pRes;
 	}
 
@@ -204,6 +213,7 @@ public:
 
 		memcpy ( pData, m_pBuf+m_tPtr, tLen );
 		m_tPtr += tLen;
+		m_iBytesRead += tLen;
 	}
 
 	FORCE_INLINE bool DoRefill()
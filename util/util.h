@@ -76,6 +76,13 @@ public:
 		, m_tLength ( dVec.size() )
 	{}
 
+	// read-only view of a mutable span
+	template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+	Span_T ( const Span_T<U> & dSpan )
+		: m_pData ( dSpan.data() )
+		, m_tLength ( dSpan.size() )
+	{}
+
 	T *     data() const    { return m_pData; }
 	T &     front() const   { return *m_pData; }
 	T &     back() const    { return *(m_pData+m_tLength-1); }
@@ -287,6 +287,38 @@ inline float UintToFloat ( uint32_t uValue )
 	return tUnion.m_fValue;
 }
 
+// decimal float encoding: a float is stored as an integer scaled by 10^exp
+// the decoder must use exactly the same formula, so both sides go through DecimalToFloat
+const int MAX_FLOAT_DECIMAL_EXP = 10;
+
+FORCE_INLINE double GetFloatDecimalScale ( int iExp )
+{
+	static const double dScales[MAX_FLOAT_DECIMAL_EXP+1] = { 1e0, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8, 1e-9, 1e-10 };
+	return dScales[iExp];
+}
+
+
+FORCE_INLINE float DecimalToFloat ( int32_t iValue, int iExp )
+{
+	return float ( double(iValue)*GetFloatDecimalScale(iExp) );
+}
+
+
+FORCE_INLINE bool FloatToDecimal ( float fValue, int iExp, int32_t & iValue )
+{
+	static const double dPow10[MAX_FLOAT_DECIMAL_EXP+1] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10 };
+	double dValue = double(fValue)*dPow10[iExp];
+
+	// also rejects NaNs
+	if ( !( dValue>-2147483647.0 && dValue<2147483647.0 ) )
+		return false;
+
+	iValue = (int32_t)std::llround(dValue);
+
+	// bitwise check, so -0.0 and anything not representable as a decimal is rejected
+	return FloatToUint ( DecimalToFloat ( iValue, iExp ) )==FloatToUint(fValue);
+}
+
 template <typename T>
 constexpr auto to_underlying(T t) noexcept
 {
@@ -559,6 +591,8 @@ inline int FillWithIncreasingValues ( uint32_t *& pRowID, size_t uNumValues, uin
         pRowID += 4;
     }
 
+    tRowID += (uint32_t)uValuesInBlocks;
+
     size_t uValuesLeft = uNumValues - uValuesInBlocks;
     pRowIDMax = pRowID + uValuesLeft;
     while ( pRowID < pRowIDMax )